@@ -0,0 +1,97 @@
+// Web Worker do modo lockstep: recebe as mensagens de pico/life/lockstep,
+// roda o mesmo kernel do Pico e devolve os quadros para script.js.
+importScripts("life.js");
+
+let grid = null;
+let next = null;
+let rule = null;
+let generation = 0;
+let synced = false;
+let seed = null; // semente sendo recebida
+
+const requestResync = (reason) => {
+  synced = false;
+  postMessage({ type: "resync", reason });
+};
+
+const publishFrame = () => {
+  postMessage({
+    type: "frame",
+    generation,
+    width: grid.width,
+    height: grid.height,
+    stride: grid.stride,
+    cells: grid.cells.slice(),
+  });
+};
+
+// Avança até a geração anunciada pelo Pico
+const advanceTo = (target) => {
+  while (generation < target) {
+    lifeStep(grid, next, rule);
+    [grid, next] = [next, grid];
+    generation++;
+  }
+};
+
+const handleSeed = (cmd, args) => {
+  if (cmd === "H") {
+    const parsedRule = lifeParseRule(args[3] || "");
+    if (!parsedRule) return requestResync("regra inválida");
+    seed = {
+      generation: Number(args[0]),
+      grid: lifeCreate(Number(args[1]), Number(args[2])),
+      rule: parsedRule,
+    };
+    return;
+  }
+  if (!seed) return; // linhas de uma semente cujo cabeçalho perdemos
+
+  if (cmd === "S") {
+    const row = Number(args[0]);
+    const hex = args[1] || "";
+    const { cells, stride } = seed.grid;
+    for (let i = 0; i * 8 < hex.length; i++) {
+      const index = row * stride + i;
+      if (index < cells.length)
+        cells[index] = parseInt(hex.substr(i * 8, 8), 16);
+    }
+    return;
+  }
+
+  // "E": semente completa, confere o checksum antes de adotar
+  const expected = parseInt(args[1], 16);
+  if (lifeChecksum(seed.grid) !== expected) {
+    seed = null;
+    return requestResync("semente corrompida");
+  }
+  grid = seed.grid;
+  next = lifeCreate(grid.width, grid.height);
+  rule = seed.rule;
+  generation = seed.generation;
+  seed = null;
+  synced = true;
+  publishFrame();
+};
+
+const handleTick = (args) => {
+  if (!synced) {
+    // Perdemos a semente (ou chegamos no meio do jogo): pede outra
+    if (!seed) requestResync("sem semente");
+    return;
+  }
+  const target = Number(args[0]);
+  if (target < generation) return requestResync("geração voltou");
+  advanceTo(target);
+
+  // Drift: checksum diferente do firmware, pede nova semente
+  if (args.length > 1 && lifeChecksum(grid) !== parseInt(args[1], 16))
+    return requestResync(`checksum divergente na geração ${target}`);
+  publishFrame();
+};
+
+onmessage = (event) => {
+  const [cmd, ...args] = String(event.data).trim().split(/\s+/);
+  if (cmd === "H" || cmd === "S" || cmd === "E") handleSeed(cmd, args);
+  else if (cmd === "T") handleTick(args);
+};
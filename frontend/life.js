@@ -0,0 +1,101 @@
+// Kernel do Jogo da Vida idêntico ao do firmware (src/life.c): células
+// empacotadas por linha em palavras de 32 bits, bit i da palavra w = coluna
+// w * 32 + i, bordas mortas. Qualquer mudança aqui precisa ir para o C também.
+
+const LIFE_WORD_BITS = 32;
+
+function lifeCreate(width, height) {
+  const stride = Math.ceil(width / LIFE_WORD_BITS);
+  return { width, height, stride, cells: new Uint32Array(stride * height) };
+}
+
+// "B3/S23" -> { birth, survive } com bit n = n vizinhos
+function lifeParseRule(text) {
+  const match = /^B([0-8]*)\/S([0-8]*)$/i.exec(text.trim());
+  if (!match) return null;
+  const mask = (digits) =>
+    [...digits].reduce((acc, d) => acc | (1 << Number(d)), 0);
+  return { birth: mask(match[1]), survive: mask(match[2]) };
+}
+
+function lifeGet(grid, x, y) {
+  if (x < 0 || x >= grid.width || y < 0 || y >= grid.height) return false;
+  const word = grid.cells[y * grid.stride + (x >>> 5)];
+  return ((word >>> (x & 31)) & 1) === 1;
+}
+
+function lifeStep(cur, next, rule) {
+  const { width, height, stride } = cur;
+  const src = cur.cells;
+  const dst = next.cells;
+  const counts = rule.birth | rule.survive;
+  const s = new Uint32Array(4);
+
+  const wordAt = (row, w) =>
+    row >= 0 && row < height && w >= 0 && w < stride ? src[row * stride + w] : 0;
+
+  const addPlane = (v) => {
+    const c0 = s[0] & v;
+    s[0] ^= v;
+    const c1 = s[1] & c0;
+    s[1] ^= c0;
+    const c2 = s[2] & c1;
+    s[2] ^= c1;
+    s[3] |= c2;
+  };
+
+  const addRow = (row, w, center) => {
+    if (row < 0 || row >= height) return;
+    const a = wordAt(row, w);
+    addPlane((a << 1) | (wordAt(row, w - 1) >>> 31));
+    addPlane((a >>> 1) | (wordAt(row, w + 1) << 31));
+    if (center) addPlane(a);
+  };
+
+  for (let y = 0; y < height; y++) {
+    for (let w = 0; w < stride; w++) {
+      s.fill(0);
+      addRow(y - 1, w, true);
+      addRow(y, w, false);
+      addRow(y + 1, w, true);
+
+      let born = 0;
+      let keep = 0;
+      for (let n = 0; n <= 8; n++) {
+        if (!((counts >>> n) & 1)) continue;
+        const eq =
+          (n & 1 ? s[0] : ~s[0]) &
+          (n & 2 ? s[1] : ~s[1]) &
+          (n & 4 ? s[2] : ~s[2]) &
+          (n & 8 ? s[3] : ~s[3]);
+        if ((rule.birth >>> n) & 1) born |= eq;
+        if ((rule.survive >>> n) & 1) keep |= eq;
+      }
+
+      const bits = width - w * LIFE_WORD_BITS;
+      const mask = bits >= LIFE_WORD_BITS ? 0xffffffff : (1 << bits) - 1;
+      const alive = src[y * stride + w];
+      dst[y * stride + w] = ((alive & keep) | (~alive & born)) & mask;
+    }
+  }
+}
+
+// FNV-1a igual a life_checksum()
+function lifeChecksum(grid) {
+  let h = 2166136261;
+  h = Math.imul(h ^ grid.width, 16777619) >>> 0;
+  h = Math.imul(h ^ grid.height, 16777619) >>> 0;
+  for (let i = 0; i < grid.cells.length; i++)
+    h = Math.imul(h ^ grid.cells[i], 16777619) >>> 0;
+  return h;
+}
+
+if (typeof module !== "undefined") {
+  module.exports = {
+    lifeCreate,
+    lifeParseRule,
+    lifeGet,
+    lifeStep,
+    lifeChecksum,
+  };
+}
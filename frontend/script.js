@@ -77,3 +77,56 @@ document.getElementById("sendBtn").addEventListener("click", () => {
   client.publish("pico/life", message);
   console.log("Mensagem enviada:", message);
 });
+
+// ---------- Modo lockstep ----------
+// O Pico publica só a semente e os ticks de geração em pico/life/lockstep;
+// o worker roda o mesmo kernel e manda os quadros para desenhar aqui.
+const LOCKSTEP_TOPIC = "pico/life/lockstep";
+const LOCKSTEP_RESYNC_TOPIC = "pico/life/lockstep/resync";
+const RESYNC_INTERVAL_MS = 2000;
+
+const worker = new Worker("life-worker.js");
+let mirroring = false;
+let lastResyncMs = 0;
+
+const requestResync = (reason) => {
+  const now = Date.now();
+  if (now - lastResyncMs < RESYNC_INTERVAL_MS) return;
+  lastResyncMs = now;
+  console.log("Lockstep: pedindo ressincronização:", reason);
+  client.publish(LOCKSTEP_RESYNC_TOPIC, reason);
+};
+
+client.on("connect", () => {
+  client.subscribe(LOCKSTEP_TOPIC);
+  requestResync("cliente conectado");
+});
+
+client.on("message", (topic, payload) => {
+  if (topic === LOCKSTEP_TOPIC) worker.postMessage(payload.toString());
+});
+
+worker.onmessage = (event) => {
+  const msg = event.data;
+  if (msg.type === "resync") requestResync(msg.reason);
+  else if (msg.type === "frame" && mirroring) renderFrame(msg);
+};
+
+// Desenha a parte visível (128x64) do tabuleiro simulado
+const renderFrame = ({ cells, stride }) => {
+  for (let y = 0; y < 64; y++) {
+    for (let x = 0; x < 128; x++) {
+      const alive = (cells[y * stride + (x >>> 5)] >>> (x & 31)) & 1;
+      pixels[y * 128 + x].classList.toggle("alive", alive === 1);
+    }
+  }
+};
+
+// Botão espelhar: mostra a simulação do Pico no lugar do desenho
+const mirrorBtn = document.getElementById("mirrorBtn");
+mirrorBtn.addEventListener("click", () => {
+  mirroring = !mirroring;
+  mirrorBtn.textContent = mirroring ? "Parar Espelho" : "Espelhar Pico";
+  oled.classList.toggle("mirroring", mirroring);
+  if (!mirroring) pixels.forEach((p) => p.classList.remove("alive"));
+});
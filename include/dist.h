@@ -0,0 +1,112 @@
+#ifndef DIST_H
+#define DIST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "life.h"
+
+// ---------------- Distributed configuration ----------------
+// Cada nó (Pico W) é dono de um tile 128x64 do universo e troca as bordas com
+// os 8 vizinhos a cada geração. O tabuleiro local tem 1 célula de halo em
+// cada lado, preenchida com as bordas recebidas antes de cada passo.
+#define DIST_TILE_WIDTH   128
+#define DIST_TILE_HEIGHT  64
+#define DIST_LOCAL_WIDTH  (DIST_TILE_WIDTH + 2)
+#define DIST_LOCAL_HEIGHT (DIST_TILE_HEIGHT + 2)
+#define DIST_HALO_TOPIC   "pico/life/dist/halo" // + "/<col>-<row>"
+#define DIST_TIMEOUT_MS   2000 // vizinho em silêncio por esse tempo = nó caiu
+// Quem espera republica o halo da geração atual de tempos em tempos: mostra
+// aos vizinhos que está vivo (só esperando outro) e cobre halo perdido
+#define DIST_HEARTBEATS_PER_TIMEOUT 4
+
+// Mensagem de halo (binária, little-endian), só as bordas não vazias:
+//   [0..3] geração  [4] coluna  [5] linha  [6] flags (bit por borda presente)
+//   [7] vizinhos que quem publicou deu como caídos (bit por vizinho, sem o
+//   próprio nó: índices 0..3 e 5..8 viram bits 0..7)
+//   topo (16 bytes) | base (16 bytes) | esquerda (8 bytes) | direita (8 bytes)
+// Nas colunas, o bit y % 8 do byte y / 8 é a linha y do tile.
+#define DIST_HALO_HEADER  8
+#define DIST_HALO_MAX     (DIST_HALO_HEADER + 2 * (DIST_TILE_WIDTH / 8) + 2 * (DIST_TILE_HEIGHT / 8))
+
+enum {
+    DIST_EDGE_TOP = 1 << 0,
+    DIST_EDGE_BOTTOM = 1 << 1,
+    DIST_EDGE_LEFT = 1 << 2,
+    DIST_EDGE_RIGHT = 1 << 3,
+};
+
+// Bordas de um tile como chegaram na mensagem
+typedef struct {
+    uint32_t generation;
+    uint8_t down; // vizinhos caídos para quem publicou
+    uint8_t top[DIST_TILE_WIDTH / 8];
+    uint8_t bottom[DIST_TILE_WIDTH / 8];
+    uint8_t left[DIST_TILE_HEIGHT / 8];
+    uint8_t right[DIST_TILE_HEIGHT / 8];
+} dist_halo_t;
+
+// Publicação fica por conta de quem hospeda o nó (lwIP MQTT no Pico,
+// broker loopback no simulador de host). false = a mensagem não saiu (ex.
+// buffer de envio cheio) e o nó tenta de novo no próximo poll.
+typedef struct {
+    bool (*publish)(void *ctx, const char *topic, const uint8_t *payload, int len);
+    void *ctx;
+} dist_transport_t;
+
+typedef struct {
+    uint8_t col, row;   // posição deste nó
+    uint8_t cols, rows; // tamanho da malha de nós
+    life_rule_t rule;
+    uint32_t generation;
+    uint32_t timeout_ms;
+
+    life_grid_t grid;
+    life_grid_t next;
+    uint32_t cells[LIFE_GRID_WORDS(DIST_LOCAL_WIDTH, DIST_LOCAL_HEIGHT)];
+    uint32_t next_cells[LIFE_GRID_WORDS(DIST_LOCAL_WIDTH, DIST_LOCAL_HEIGHT)];
+
+    // Vizinhos 0..8 = (dc + 1) + 3 * (dr + 1), 4 é o próprio nó.
+    // Dois slots por vizinho (geração par/ímpar): um vizinho pode estar
+    // uma geração à frente enquanto esperamos outro.
+    dist_halo_t halos[2][9];
+    bool have[2][9];
+    bool down[9];
+    uint32_t latest[9];   // última geração ouvida de cada vizinho
+    bool heard[9];        // mensagem desde o último poll
+    uint32_t heard_ms[9];
+
+    char topic[40];      // DIST_HALO_TOPIC "/<col>-<row>"
+    bool published;      // halo da geração atual já saiu
+    bool fresh;          // recém iniciado, ainda sem passo: adota a geração da malha
+    uint32_t wait_start_ms;
+    uint32_t published_ms;
+    dist_transport_t transport;
+
+    // Estatísticas
+    uint32_t halos_sent;
+    uint32_t halo_bytes_sent;
+    uint32_t publish_failures;
+    uint32_t halos_missed; // vizinho passou da geração sem o halo chegar
+    uint32_t timeouts;
+    uint32_t rejoins;
+} dist_node_t;
+
+// ---------------- API ----------------
+void dist_node_init(dist_node_t *node, int col, int row, int cols, int rows,
+                    life_rule_t rule, dist_transport_t transport);
+
+// Carrega o tile a partir de (ox, oy) de um tabuleiro maior
+void dist_node_load(dist_node_t *node, const life_grid_t *src, int ox, int oy);
+
+// Entrega uma mensagem de halo recebida (qualquer nó, inclusive o próprio)
+void dist_node_on_message(dist_node_t *node, const uint8_t *payload, int len);
+
+// Publica o halo e avança uma geração quando a barreira libera; true se avançou
+bool dist_node_poll(dist_node_t *node, uint32_t now_ms);
+
+bool dist_node_get(const dist_node_t *node, int x, int y);
+
+int dist_encode_halo(const dist_node_t *node, uint8_t *out);
+bool dist_decode_halo(const uint8_t *payload, int len, int *col, int *row, dist_halo_t *halo);
+
+#endif // DIST_H
@@ -0,0 +1,73 @@
+#ifndef GAME_H
+#define GAME_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "life.h"
+#include "ssd1306_gfx.h"
+#include "view.h"
+#include "ingest.h"
+
+// Estado e regras do jogo sem nada de hardware: main.c liga botões, joystick,
+// MQTT e display aqui, e tools/replay roda o mesmo código no host.
+
+// ---------------- Configuração ----------------
+#define LIFE_RENDER_WIDTH ssd1306_width   // 128
+#define LIFE_RENDER_HEIGHT ssd1306_height // 64
+
+#define LIFE_GRID_WIDTH 136 // tabuleiro maior que render
+#define LIFE_GRID_HEIGHT 72
+
+// Idade das células (planos de bits em life_age) mostrada em tons de cinza
+// por dithering temporal; só no tabuleiro local, não no modo distribuído.
+// Numa regra Generations os planos guardam os estados e o cinza é o das
+// células morrendo
+#ifndef LIFE_AGE
+#define LIFE_AGE 0
+#endif
+
+// Regra do jogo (life.h). Generations (LIFE_RULE_BRIANS_BRAIN, ...) usa os
+// planos de life_age para os estados e precisa de LIFE_AGE: sem ele a viva
+// que não sobrevive morre direto, como em B/S
+#ifndef LIFE_RULE
+#define LIFE_RULE LIFE_RULE_CONWAY
+#endif
+
+// Redução no zoom afastado: VIEW_REDUCE_OR não perde células isoladas,
+// VIEW_REDUCE_DENSITY mostra melhor regiões cheias
+#ifndef LIFE_VIEW_REDUCE
+#define LIFE_VIEW_REDUCE VIEW_REDUCE_OR
+#endif
+
+// ---------------- Estado ----------------
+extern life_grid_t life_grid;
+extern life_rule_t life_rule;
+extern uint32_t life_generation;
+
+extern int cursor_x;
+extern int cursor_y;
+extern view_t life_view; // zoom e deslocamento do display
+extern ingest_t life_ingest; // parser e estatísticas dos padrões via MQTT
+#if LIFE_AGE
+extern life_age_t life_age;
+#endif
+
+extern volatile bool life_running;
+// Tabuleiro mudou fora do passo (desenho, reset, padrão via MQTT)
+extern volatile bool life_dirty;
+
+// ---------------- API ----------------
+void game_init(void);
+
+void game_press_a(void);       // desenho: inverte a célula do cursor; rodando: troca o zoom
+void game_press_b(void);       // começa o jogo ou volta para o desenho
+void game_move_cursor(int dx, int dy); // desenho: move o cursor; rodando: move a janela
+void game_ingest_begin(uint32_t total_length); // nova mensagem em pico/life
+void game_ingest(const uint8_t *data, int len, bool last); // pedaço do payload "[[x,y],...]"
+
+void update_life(void);
+// Desenha no framebuffer a janela life_view do tabuleiro, sem as ox/oy
+// células de cada borda (halo do modo distribuído)
+void render_life(uint8_t *buf, const life_grid_t *grid, int ox, int oy, uint32_t now_ms);
+
+#endif // GAME_H
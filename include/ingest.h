@@ -0,0 +1,58 @@
+#ifndef INGEST_H
+#define INGEST_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "life.h"
+
+// ---------------- Payload de pico/life ----------------
+// Parser incremental do payload "[[x,y],[x,y],...]" (também aceita
+// "[x,y][x,y]..."). Recebe os pedaços como o lwIP entrega, de qualquer
+// tamanho e cortados em qualquer ponto, com memória fixa: o estado é só a
+// tupla em andamento. As células vão para um tabuleiro de staging e entram
+// no jogo inteiras no fim da mensagem (ingest_commit).
+#define INGEST_MAX_COORD (1 << 20) // números maiores param de crescer (já estão fora)
+
+typedef struct {
+    uint32_t messages;     // mensagens aplicadas
+    uint64_t bytes;
+    uint64_t cells;        // células novas no tabuleiro de staging
+    uint32_t out_of_range; // coordenadas fora do tabuleiro
+    uint32_t malformed;    // tuplas que não eram "[x,y]"
+    uint32_t dropped;      // mensagens incompletas, descartadas
+} ingest_stats_t;
+
+typedef struct {
+    life_grid_t staging;
+
+    // Tupla em andamento
+    bool open;      // depois de '['
+    bool in_number;
+    bool negative;
+    uint8_t count;  // números já lidos na tupla
+    int32_t value;
+    int32_t pair[2];
+
+    // Mensagem em andamento
+    bool active;
+    uint32_t expected; // tamanho anunciado pelo MQTT, 0 = não sabe
+    uint32_t received;
+    uint32_t staged;
+    int row_lo, row_hi; // linhas sujas do staging
+
+    ingest_stats_t stats;
+} ingest_t;
+
+// ---------------- API ----------------
+// cells: LIFE_GRID_WORDS(width, height) palavras para o staging
+void ingest_init(ingest_t *in, uint32_t *cells, int width, int height);
+
+// Nova mensagem de total_length bytes (0 se não souber); uma mensagem
+// anterior que não terminou conta como descartada
+void ingest_begin(ingest_t *in, uint32_t total_length);
+void ingest_feed(ingest_t *in, const uint8_t *data, int len);
+// Fim da mensagem: junta o staging em dst e devolve quantas células a
+// mensagem trouxe (0 e descartada se veio menos que o anunciado)
+int ingest_commit(ingest_t *in, life_grid_t *dst);
+
+#endif // INGEST_H
@@ -0,0 +1,98 @@
+#ifndef LIFE_H
+#define LIFE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ---------------- Grid layout ----------------
+// Células empacotadas por linha em palavras de 32 bits: o bit i da palavra w
+// é a coluna w * 32 + i. Palavras de 32 bits porque é o que os operadores bit a
+// bit do JavaScript manipulam, e o frontend roda o mesmo kernel (frontend/life.js).
+#define LIFE_WORD_BITS 32
+#define LIFE_STRIDE(width) (((width) + LIFE_WORD_BITS - 1) / LIFE_WORD_BITS)
+#define LIFE_GRID_WORDS(width, height) ((height) * LIFE_STRIDE(width))
+
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t stride;  // palavras por linha
+    uint32_t *cells;  // height * stride palavras; bits além de width ficam em zero
+} life_grid_t;
+
+// Regra totalística: bit n de birth/survive = nasce/sobrevive com n vizinhos.
+// states > 2 é uma regra Generations ("B2/S/C3"): a viva que não sobrevive
+// passa pelos estados 2 .. states - 1 antes de morrer, sem contar como
+// vizinha e sem poder nascer de novo enquanto isso (ver life_step_gen)
+typedef struct {
+    uint16_t birth;
+    uint16_t survive;
+    uint8_t states; // 0 ou 2: só viva e morta
+} life_rule_t;
+
+#define LIFE_RULE_CONWAY ((life_rule_t){ .birth = 1u << 3, .survive = (1u << 2) | (1u << 3) })
+#define LIFE_RULE_BRIANS_BRAIN ((life_rule_t){ .birth = 1u << 2, .survive = 0, .states = 3 })
+#define LIFE_RULE_STAR_WARS ((life_rule_t){ .birth = 1u << 2, .survive = 7u << 3, .states = 4 })
+
+// Idade das células vivas em planos de bits no formato do tabuleiro: o bit k
+// da idade da célula (x, y) fica no plano k. Nasce com 0, cresce uma vez por
+// geração e para em LIFE_AGE_MAX; células mortas ficam com 0.
+#define LIFE_AGE_BITS 3
+#define LIFE_AGE_MAX ((1 << LIFE_AGE_BITS) - 1)
+// Nas regras Generations os mesmos planos guardam o estado - 1 das células
+// morrendo, então cabem até LIFE_AGE_MAX + 2 estados
+#define LIFE_GEN_STATES_MAX (LIFE_AGE_MAX + 2)
+
+typedef struct {
+    life_grid_t planes[LIFE_AGE_BITS];
+} life_age_t;
+
+// ---------------- API ----------------
+void life_grid_init(life_grid_t *grid, uint32_t *cells, int width, int height);
+void life_clear(life_grid_t *grid);
+void life_copy(life_grid_t *dst, const life_grid_t *src);
+bool life_get(const life_grid_t *grid, int x, int y);
+void life_set(life_grid_t *grid, int x, int y, bool on);
+int life_population(const life_grid_t *grid);
+
+// Uma geração; células fora do tabuleiro contam como mortas
+void life_step(const life_grid_t *cur, life_grid_t *next, life_rule_t rule);
+
+// cells: LIFE_AGE_BITS * LIFE_GRID_WORDS(width, height) palavras
+void life_age_init(life_age_t *age, uint32_t *cells, int width, int height);
+// Zera todos os planos; junto de todo life_clear do tabuleiro, senão uma
+// célula desenhada depois herda a idade da que estava ali
+void life_age_clear(life_age_t *age);
+int life_age_get(const life_age_t *age, int x, int y);
+// life_step que também atualiza a idade, bit a bit no mesmo laço
+void life_step_age(const life_grid_t *cur, life_grid_t *next, life_rule_t rule, life_age_t *age);
+// Passo de uma regra Generations: next recebe só as vivas (estado 1) e
+// dying, no formato dos planos de idade, o estado - 1 das que estão morrendo
+// (0 nas vivas e mortas). Com rule.states <= 2 é o mesmo que life_step e
+// zera os planos.
+void life_step_gen(const life_grid_t *cur, life_grid_t *next, life_rule_t rule, life_age_t *dying);
+
+// Lote de universos independentes de 32 x height células, uma palavra por
+// linha: a linha y do universo u fica em cells[y * count + u]. Assim o laço
+// interno anda por universos vizinhos na memória e vira SIMD no host (busca
+// de sopas em tools/soup_search). Mesmo resultado que life_step em cada um.
+void life_step_batch(const uint32_t *cur, uint32_t *next, int height, int count, life_rule_t rule);
+
+// FNV-1a sobre as dimensões e as palavras, na ordem das linhas
+uint32_t life_checksum(const life_grid_t *grid);
+
+#define LIFE_RULE_TEXT_MAX 32 // maior regra escrita, com o '\0'
+
+// Escreve a regra como "B3/S23" ("B2/S/C3" se for Generations); retorna o
+// tamanho da string
+int life_format_rule(life_rule_t rule, char *buf, size_t size);
+// Lê "B3/S23", "23/3", "B2/S/C3" ou "/2/3"; false se o texto não for uma
+// regra ou tiver mais de LIFE_GEN_STATES_MAX estados
+bool life_parse_rule(const char *text, life_rule_t *rule);
+
+static inline uint32_t *life_row(const life_grid_t *grid, int y)
+{
+    return grid->cells + (size_t)y * grid->stride;
+}
+
+#endif // LIFE_H
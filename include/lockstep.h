@@ -0,0 +1,28 @@
+#ifndef LOCKSTEP_H
+#define LOCKSTEP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "life.h"
+#include "lwip/apps/mqtt.h"
+
+// ---------------- Lockstep configuration ----------------
+// O Pico publica só a semente (padrão + regra) e o relógio de gerações; os
+// clientes web rodam o mesmo kernel (frontend/life.js) e ficam em sincronia.
+#define LOCKSTEP_TOPIC        "pico/life/lockstep"
+#define LOCKSTEP_RESYNC_TOPIC "pico/life/lockstep/resync"
+#define LOCKSTEP_SEED_ROWS    4  // linhas por mensagem "S" (cabe no ring buffer do MQTT)
+#define LOCKSTEP_CHECK_EVERY  16 // gerações entre checksums nos ticks
+
+// Protocolo (texto, um comando por mensagem):
+//   H <gen> <largura> <altura> <regra>   início da semente, ex. "H 0 136 72 B3/S23"
+//   S <linha> <hex...>                   LOCKSTEP_SEED_ROWS linhas, 8 dígitos por palavra
+//   E <gen> <checksum>                   fim da semente, checksum de life_checksum()
+//   T <gen> [checksum]                   tick; gen absoluta, clientes avançam até ela
+
+// ---------------- API ----------------
+void lockstep_init(const life_grid_t *grid, const life_rule_t *rule, const uint32_t *generation);
+void lockstep_request_seed(void);
+void lockstep_poll(mqtt_client_t *client);
+
+#endif // LOCKSTEP_H
@@ -52,13 +52,17 @@
 #define DHCP_DOES_ARP_CHECK         0
 #define LWIP_DHCP_DOES_ACD_CHECK    0
 
+// Mensagens de debug do lwIP só com LWIP_VERBOSE: com MQTT_DEBUG ligado cada
+// pedaço recebido vira um printf e a recepção de padrões grandes para
 #ifndef NDEBUG
+#ifdef LWIP_VERBOSE
 #define LWIP_DEBUG                  1
+#endif
 #define LWIP_STATS                  1
 #define LWIP_STATS_DISPLAY          1
 #endif
 
-#define MQTT_DEBUG                LWIP_DBG_ON
+#define MQTT_DEBUG                  LWIP_DBG_OFF
 #define ETHARP_DEBUG                LWIP_DBG_OFF
 #define NETIF_DEBUG                 LWIP_DBG_OFF
 #define PBUF_DEBUG                  LWIP_DBG_OFF
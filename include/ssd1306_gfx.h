@@ -0,0 +1,39 @@
+#ifndef SSD1306_GFX_H
+#define SSD1306_GFX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Desenho no framebuffer em memória (formato de páginas do SSD1306: cada
+// byte são 8 pixels na vertical). Não depende do I2C, compila no host também.
+
+// ---------------- Display configuration ----------------
+#define ssd1306_width   128
+#define ssd1306_height   64
+#define ssd1306_page_height 8
+#define ssd1306_n_pages (ssd1306_height / ssd1306_page_height)
+#define ssd1306_buffer_length (ssd1306_width * ssd1306_n_pages)
+
+// Operação do blit sobre os pixels de destino
+typedef enum {
+    SSD1306_BLIT_COPY, // destino = origem
+    SSD1306_BLIT_OR,
+    SSD1306_BLIT_AND,
+    SSD1306_BLIT_XOR,
+} ssd1306_blit_op_t;
+
+// ---------------- API ----------------
+void ssd1306_set_pixel(uint8_t *buf, int x, int y, bool on);
+void ssd1306_clear(uint8_t *buf);
+void ssd1306_draw_points(uint8_t *buf, int points[][2], int n_points);
+void ssd1306_draw_line(uint8_t *buf, int x0, int y0, int x1, int y1, bool on);
+// Copia um bitmap w x h no formato de páginas (byte [página * w + coluna],
+// bit = linha % 8, como a fonte) para (x, y) qualquer, cortando nas bordas
+void ssd1306_blit(uint8_t *buf, int x, int y, const uint8_t *bitmap, int w, int h,
+                  ssd1306_blit_op_t op);
+void ssd1306_fill_rect(uint8_t *buf, int x, int y, int w, int h, bool on);
+void ssd1306_invert_rect(uint8_t *buf, int x, int y, int w, int h);
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character);
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string);
+
+#endif // SSD1306_GFX_H
@@ -0,0 +1,86 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// ---------------- Trace format ----------------
+// Gravação das entradas do jogo para replay determinístico (no Pico ou no
+// host com tools/replay). Cabeçalho "JDVT" + versão, depois eventos:
+//   [tipo: 1 byte][delta ms desde o evento anterior: varint][payload]
+// TRACE_FRAME marca o fim das entradas de uma volta do loop principal, antes
+// do render; payload = 1 byte, 1 se update_life() rodou nessa volta.
+// TRACE_MOVE: dx, dy (int8). TRACE_MQTT_BEGIN: início de uma mensagem em
+// pico/life, total_length anunciado pelo MQTT (varint). TRACE_MQTT: flags
+// (1 = último pedaço), tamanho (varint) e os bytes recebidos em pico/life.
+// TRACE_DROPPED: eventos perdidos com o buffer cheio logo antes deste ponto
+// (varint); o replay a partir daí não é mais o da sessão gravada.
+// TRACE_TRUNCATED: sem payload, a flash encheu e a gravação parou aqui.
+// Flash apagada (0xFF) lê como TRACE_END.
+#define TRACE_MAGIC       "JDVT"
+#define TRACE_VERSION     3
+#define TRACE_HEADER_LEN  5
+#define TRACE_EVENT_MAX   12 // maior evento sem contar os bytes de TRACE_MQTT
+
+typedef enum {
+    TRACE_FRAME = 0,
+    TRACE_BTN_A = 1,
+    TRACE_BTN_B = 2,
+    TRACE_MOVE  = 3,
+    TRACE_MQTT  = 4,
+    TRACE_MQTT_BEGIN = 5,
+    TRACE_DROPPED = 6,
+    TRACE_TRUNCATED = 7,
+    TRACE_END   = 0xFF,
+} trace_type_t;
+
+typedef struct {
+    uint8_t type;
+    uint32_t time_ms;     // desde o início da gravação
+    uint8_t stepped;      // TRACE_FRAME
+    int8_t dx, dy;        // TRACE_MOVE
+    bool last;            // TRACE_MQTT
+    uint32_t total_length; // TRACE_MQTT_BEGIN
+    uint32_t count;       // TRACE_DROPPED
+    const uint8_t *data;  // TRACE_MQTT
+    uint16_t len;
+} trace_event_t;
+
+// ---------------- Writer ----------------
+// Acumula eventos em RAM; quem grava decide quando descarregar (USB ou flash).
+// Não trava nada: no Pico, trace_write() é chamado com interrupções desligadas.
+#define TRACE_BUFFER_SIZE 2048
+
+typedef struct {
+    uint8_t buf[TRACE_BUFFER_SIZE];
+    int len;
+    uint32_t last_ms;
+    uint32_t dropped;    // eventos perdidos com o buffer cheio, no total
+    uint32_t unreported; // perdidos que ainda não viraram TRACE_DROPPED
+} trace_writer_t;
+
+void trace_writer_init(trace_writer_t *w);
+// Sem espaço o evento é perdido; o próximo que couber vem depois de um
+// TRACE_DROPPED com quantos foram
+void trace_write(trace_writer_t *w, const trace_event_t *ev);
+// Copia o que está pendente para out (até max bytes) e esvazia o buffer
+int trace_take(trace_writer_t *w, uint8_t *out, int max);
+// TRACE_TRUNCATED pronto para ir direto para a flash depois do último
+// evento que coube; devolve o tamanho, sempre TRACE_TRUNCATED_LEN
+#define TRACE_TRUNCATED_LEN 2
+int trace_truncated(uint8_t *out);
+
+// ---------------- Reader ----------------
+typedef struct {
+    const uint8_t *data;
+    size_t len;
+    size_t pos;
+    uint32_t time_ms;
+} trace_reader_t;
+
+bool trace_reader_init(trace_reader_t *r, const uint8_t *data, size_t len);
+// false no fim do trace (ou se estiver truncado)
+bool trace_next(trace_reader_t *r, trace_event_t *ev);
+
+#endif // TRACE_H
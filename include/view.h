@@ -0,0 +1,68 @@
+#ifndef VIEW_H
+#define VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "life.h"
+#include "ssd1306_gfx.h"
+
+// ---------------- Viewport ----------------
+// Janela do tabuleiro mostrada no display: deslocamento em células e zoom.
+// zoom > 0: cada célula vira um bloco de 2^zoom x 2^zoom pixels.
+// zoom < 0: cada pixel resume um bloco de 2^-zoom x 2^-zoom células.
+// Tudo é feito em palavras de 32 bits (linhas empacotadas do life_grid_t) e
+// convertido para o formato de páginas do SSD1306 no fim.
+#define VIEW_ZOOM_MIN -2 // 4x4 células por pixel
+#define VIEW_ZOOM_MAX 3  // 8x8 pixels por célula
+
+// Limiar do modo densidade: pixel aceso com pelo menos N células vivas no bloco
+#ifndef VIEW_DENSITY_2X2
+#define VIEW_DENSITY_2X2 2
+#endif
+#ifndef VIEW_DENSITY_4X4
+#define VIEW_DENSITY_4X4 4
+#endif
+
+typedef enum {
+    VIEW_REDUCE_OR,      // pixel aceso se qualquer célula do bloco vive
+    VIEW_REDUCE_DENSITY, // pixel aceso acima do limiar de densidade
+} view_reduce_t;
+
+// Idade em tons de cinza: num ciclo de VIEW_GREY_FRAMES quadros a célula
+// acende em 1..VIEW_GREY_FRAMES deles, mais vezes quanto mais nova
+#define VIEW_GREY_FRAMES 4
+
+typedef struct {
+    int x, y; // primeira célula visível
+    int zoom;
+    view_reduce_t reduce;
+} view_t;
+
+// ---------------- API ----------------
+// Células visíveis na largura/altura do display no zoom atual
+int view_cells_w(const view_t *view);
+int view_cells_h(const view_t *view);
+
+// Mantém a janela dentro de cols x rows células
+void view_clamp(view_t *view, int cols, int rows);
+void view_pan(view_t *view, int dx, int dy, int cols, int rows);
+// Desloca o mínimo para que a célula (cx, cy) fique visível
+void view_follow(view_t *view, int cx, int cy, int cols, int rows);
+// Retângulo em pixels da célula (cx, cy); false se estiver fora da tela
+bool view_cell_rect(const view_t *view, int cx, int cy, int *px, int *py, int *size);
+
+// Desenha no framebuffer as células [ox, width - ox) x [oy, height - oy) do
+// tabuleiro (ox/oy > 0 esconde o halo dos tiles do modo distribuído)
+void view_render(const view_t *view, const life_grid_t *grid, int ox, int oy, uint8_t *buf);
+
+// Quadro frame do dithering temporal da idade: em out, as células de live
+// acesas neste quadro (mesmo tamanho de live). O limiar de cada célula muda
+// com a posição, para o piscar não ser o tabuleiro inteiro de uma vez.
+void view_dither_age(const life_grid_t *live, const life_age_t *age, unsigned frame,
+                     life_grid_t *out);
+// O mesmo para uma regra Generations (life_step_gen): as vivas acesas em
+// todo quadro e as que estão morrendo cada vez mais apagadas até sumir
+void view_dither_gen(const life_grid_t *live, const life_age_t *dying, int states, unsigned frame,
+                     life_grid_t *out);
+
+#endif // VIEW_H
@@ -0,0 +1,323 @@
+#include "dist.h"
+#include <stdio.h>
+#include <string.h>
+
+#define SELF 4
+
+// ---------- Helpers ----------
+
+static inline int neighbor_index(int dc, int dr) { return (dc + 1) + 3 * (dr + 1); }
+
+static bool neighbor_exists(const dist_node_t *node, int idx)
+{
+    int c = node->col + idx % 3 - 1;
+    int r = node->row + idx / 3 - 1;
+    return idx != SELF && c >= 0 && c < node->cols && r >= 0 && r < node->rows;
+}
+
+// Bit de um vizinho no byte de caídos do halo (o próprio nó não tem bit)
+static inline uint8_t down_bit(int idx) { return 1u << (idx < SELF ? idx : idx - 1); }
+
+static inline bool bit_get(const uint8_t *bytes, int i) { return (bytes[i / 8] >> (i % 8)) & 1u; }
+static inline void bit_set(uint8_t *bytes, int i) { bytes[i / 8] |= 1u << (i % 8); }
+
+static bool any_set(const uint8_t *bytes, int n)
+{
+    for (int i = 0; i < n; i++)
+        if (bytes[i])
+            return true;
+    return false;
+}
+
+// ---------- Halo encoding ----------
+
+int dist_encode_halo(const dist_node_t *node, uint8_t *out)
+{
+    dist_halo_t edges;
+    memset(&edges, 0, sizeof(edges));
+
+    // Tile (x, y) fica em (x + 1, y + 1) no tabuleiro local
+    for (int x = 0; x < DIST_TILE_WIDTH; x++)
+    {
+        if (life_get(&node->grid, x + 1, 1))
+            bit_set(edges.top, x);
+        if (life_get(&node->grid, x + 1, DIST_TILE_HEIGHT))
+            bit_set(edges.bottom, x);
+    }
+    for (int y = 0; y < DIST_TILE_HEIGHT; y++)
+    {
+        if (life_get(&node->grid, 1, y + 1))
+            bit_set(edges.left, y);
+        if (life_get(&node->grid, DIST_TILE_WIDTH, y + 1))
+            bit_set(edges.right, y);
+    }
+
+    uint32_t gen = node->generation;
+    out[0] = gen & 0xFF;
+    out[1] = (gen >> 8) & 0xFF;
+    out[2] = (gen >> 16) & 0xFF;
+    out[3] = (gen >> 24) & 0xFF;
+    out[4] = node->col;
+    out[5] = node->row;
+    uint8_t down = 0;
+    for (int i = 0; i < 9; i++)
+        if (i != SELF && node->down[i])
+            down |= down_bit(i);
+    out[7] = down;
+
+    // Bordas vazias não vão na mensagem
+    uint8_t flags = 0;
+    int len = DIST_HALO_HEADER;
+    const struct { uint8_t flag; const uint8_t *bytes; int n; } parts[] = {
+        { DIST_EDGE_TOP, edges.top, sizeof(edges.top) },
+        { DIST_EDGE_BOTTOM, edges.bottom, sizeof(edges.bottom) },
+        { DIST_EDGE_LEFT, edges.left, sizeof(edges.left) },
+        { DIST_EDGE_RIGHT, edges.right, sizeof(edges.right) },
+    };
+    for (int i = 0; i < 4; i++)
+    {
+        if (!any_set(parts[i].bytes, parts[i].n))
+            continue;
+        flags |= parts[i].flag;
+        memcpy(out + len, parts[i].bytes, parts[i].n);
+        len += parts[i].n;
+    }
+    out[6] = flags;
+    return len;
+}
+
+bool dist_decode_halo(const uint8_t *payload, int len, int *col, int *row, dist_halo_t *halo)
+{
+    if (len < DIST_HALO_HEADER)
+        return false;
+
+    memset(halo, 0, sizeof(*halo));
+    halo->generation = payload[0] | (payload[1] << 8) | (payload[2] << 16) | ((uint32_t)payload[3] << 24);
+    *col = payload[4];
+    *row = payload[5];
+    halo->down = payload[7];
+
+    uint8_t flags = payload[6];
+    int pos = DIST_HALO_HEADER;
+    struct { uint8_t flag; uint8_t *bytes; int n; } parts[] = {
+        { DIST_EDGE_TOP, halo->top, sizeof(halo->top) },
+        { DIST_EDGE_BOTTOM, halo->bottom, sizeof(halo->bottom) },
+        { DIST_EDGE_LEFT, halo->left, sizeof(halo->left) },
+        { DIST_EDGE_RIGHT, halo->right, sizeof(halo->right) },
+    };
+    for (int i = 0; i < 4; i++)
+    {
+        if (!(flags & parts[i].flag))
+            continue;
+        if (pos + parts[i].n > len)
+            return false;
+        memcpy(parts[i].bytes, payload + pos, parts[i].n);
+        pos += parts[i].n;
+    }
+    return pos == len;
+}
+
+// ---------- Node ----------
+
+void dist_node_init(dist_node_t *node, int col, int row, int cols, int rows,
+                    life_rule_t rule, dist_transport_t transport)
+{
+    memset(node, 0, sizeof(*node));
+    node->col = col;
+    node->row = row;
+    node->cols = cols;
+    node->rows = rows;
+    node->rule = rule;
+    node->timeout_ms = DIST_TIMEOUT_MS;
+    node->transport = transport;
+    node->fresh = true;
+    snprintf(node->topic, sizeof(node->topic), "%s/%d-%d", DIST_HALO_TOPIC, col, row);
+    life_grid_init(&node->grid, node->cells, DIST_LOCAL_WIDTH, DIST_LOCAL_HEIGHT);
+    life_grid_init(&node->next, node->next_cells, DIST_LOCAL_WIDTH, DIST_LOCAL_HEIGHT);
+}
+
+void dist_node_load(dist_node_t *node, const life_grid_t *src, int ox, int oy)
+{
+    life_clear(&node->grid);
+    for (int y = 0; y < DIST_TILE_HEIGHT; y++)
+        for (int x = 0; x < DIST_TILE_WIDTH; x++)
+            if (life_get(src, ox + x, oy + y))
+                life_set(&node->grid, x + 1, y + 1, true);
+}
+
+bool dist_node_get(const dist_node_t *node, int x, int y)
+{
+    if (x < 0 || x >= DIST_TILE_WIDTH || y < 0 || y >= DIST_TILE_HEIGHT)
+        return false;
+    return life_get(&node->grid, x + 1, y + 1);
+}
+
+void dist_node_on_message(dist_node_t *node, const uint8_t *payload, int len)
+{
+    int col, row;
+    dist_halo_t halo;
+    if (!dist_decode_halo(payload, len, &col, &row, &halo))
+        return;
+
+    int dc = col - node->col;
+    int dr = row - node->row;
+    if (dc < -1 || dc > 1 || dr < -1 || dr > 1 || (dc == 0 && dr == 0))
+        return;
+    int idx = neighbor_index(dc, dr);
+    node->heard[idx] = true;
+    node->latest[idx] = halo.generation;
+
+    // Halo velho (ex. vizinho que acabou de reiniciar e ainda não alcançou)
+    if (halo.generation < node->generation)
+        return;
+
+    // Vizinho mais de uma geração à frente que nos deu como caídos (ou
+    // acabamos de reiniciar): ele seguiu sem nós. Adota a geração dele e
+    // segue com o tile que temos. Se ele ainda conta conosco, quem saltou
+    // foi ele (acabou de voltar): pular junto deixaria os outros vizinhos
+    // esperando halos que não vamos mandar, então a barreira só deixa de
+    // esperar por ele até chegarmos na geração dele.
+    bool dropped_us = halo.down & down_bit(neighbor_index(-dc, -dr));
+    if (halo.generation > node->generation + 1 && (dropped_us || node->fresh))
+    {
+        printf("Dist %d-%d: alcançando geração %lu\n", node->col, node->row,
+               (unsigned long)halo.generation);
+        node->generation = halo.generation;
+        memset(node->have, 0, sizeof(node->have));
+        node->published = false;
+        node->rejoins++;
+    }
+
+    // Voltou só quando alcança: atrás de nós ele ainda não tem o que mandar
+    if (node->down[idx])
+    {
+        printf("Dist %d-%d: vizinho %d-%d voltou\n", node->col, node->row, col, row);
+        node->down[idx] = false;
+    }
+
+    if (halo.generation > node->generation + 1)
+        return; // não cabe nos dois slots; a republicação traz de novo
+    int slot = halo.generation & 1;
+    node->halos[slot][idx] = halo;
+    node->have[slot][idx] = true;
+}
+
+// Preenche o anel de halo do tabuleiro local com as bordas dos vizinhos
+static void apply_halos(dist_node_t *node, int slot)
+{
+    static const dist_halo_t empty;
+    const dist_halo_t *h[9];
+    for (int i = 0; i < 9; i++)
+        h[i] = (neighbor_exists(node, i) && node->have[slot][i]) ? &node->halos[slot][i] : &empty;
+
+    const int right = DIST_LOCAL_WIDTH - 1;
+    const int bottom = DIST_LOCAL_HEIGHT - 1;
+
+    for (int x = 0; x < DIST_TILE_WIDTH; x++)
+    {
+        life_set(&node->grid, x + 1, 0, bit_get(h[neighbor_index(0, -1)]->bottom, x));
+        life_set(&node->grid, x + 1, bottom, bit_get(h[neighbor_index(0, 1)]->top, x));
+    }
+    for (int y = 0; y < DIST_TILE_HEIGHT; y++)
+    {
+        life_set(&node->grid, 0, y + 1, bit_get(h[neighbor_index(-1, 0)]->right, y));
+        life_set(&node->grid, right, y + 1, bit_get(h[neighbor_index(1, 0)]->left, y));
+    }
+
+    const int last = DIST_TILE_WIDTH - 1;
+    life_set(&node->grid, 0, 0, bit_get(h[neighbor_index(-1, -1)]->bottom, last));
+    life_set(&node->grid, right, 0, bit_get(h[neighbor_index(1, -1)]->bottom, 0));
+    life_set(&node->grid, 0, bottom, bit_get(h[neighbor_index(-1, 1)]->top, last));
+    life_set(&node->grid, right, bottom, bit_get(h[neighbor_index(1, 1)]->top, 0));
+}
+
+// Vizinho que ainda pode mandar o halo desta geração
+static bool waiting_for(const dist_node_t *node, int slot, int i)
+{
+    return neighbor_exists(node, i) && !node->down[i] && !node->have[slot][i] &&
+           node->latest[i] <= node->generation;
+}
+
+bool dist_node_poll(dist_node_t *node, uint32_t now_ms)
+{
+    for (int i = 0; i < 9; i++)
+    {
+        if (node->heard[i])
+        {
+            node->heard[i] = false;
+            node->heard_ms[i] = now_ms;
+        }
+    }
+
+    // Sem o nosso halo os vizinhos não passam da barreira: só começa a
+    // esperar (e a contar o timeout) depois que ele saiu. Enquanto espera,
+    // republica de tempos em tempos.
+    uint32_t heartbeat_ms = node->timeout_ms / DIST_HEARTBEATS_PER_TIMEOUT;
+    if (!node->published || now_ms - node->published_ms >= heartbeat_ms)
+    {
+        uint8_t msg[DIST_HALO_MAX];
+        int len = dist_encode_halo(node, msg);
+        if (node->transport.publish(node->transport.ctx, node->topic, msg, len))
+        {
+            if (!node->published)
+                node->wait_start_ms = now_ms;
+            node->published = true;
+            node->published_ms = now_ms;
+            node->halos_sent++;
+            node->halo_bytes_sent += len;
+        }
+        else
+        {
+            node->publish_failures++;
+            if (!node->published)
+                return false; // tenta de novo no próximo poll
+        }
+    }
+
+    // Barreira: halos da geração atual de todos os vizinhos ativos. Quem já
+    // passou desta geração sem o halo chegar não manda mais; a borda dele
+    // fica morta nesta geração.
+    int slot = node->generation & 1;
+    bool ready = true;
+    for (int i = 0; i < 9; i++)
+        if (waiting_for(node, slot, i))
+            ready = false;
+
+    if (!ready)
+    {
+        if (now_ms - node->wait_start_ms < node->timeout_ms)
+            return false;
+
+        // Conta como caído quem está em silêncio há timeout_ms; quem ainda
+        // publica (esperando outro vizinho, por exemplo) segue esperado
+        bool alive = false;
+        for (int i = 0; i < 9; i++)
+        {
+            if (!waiting_for(node, slot, i))
+                continue;
+            if (now_ms - node->heard_ms[i] < node->timeout_ms)
+            {
+                alive = true;
+                continue;
+            }
+            printf("Dist %d-%d: vizinho %d-%d caiu na geração %lu\n", node->col, node->row,
+                   node->col + i % 3 - 1, node->row + i / 3 - 1, (unsigned long)node->generation);
+            node->down[i] = true;
+            node->timeouts++;
+        }
+        if (alive)
+            return false;
+    }
+
+    for (int i = 0; i < 9; i++)
+        if (neighbor_exists(node, i) && !node->down[i] && !node->have[slot][i])
+            node->halos_missed++;
+    apply_halos(node, slot);
+    life_step(&node->grid, &node->next, node->rule);
+    life_copy(&node->grid, &node->next);
+    memset(node->have[slot], 0, sizeof(node->have[slot]));
+    node->generation++;
+    node->published = false;
+    node->fresh = false;
+    return true;
+}
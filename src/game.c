@@ -0,0 +1,187 @@
+#include "game.h"
+#include <stdio.h>
+#include <string.h>
+
+// ---------- Variáveis globais ----------
+
+static uint32_t life_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+static uint32_t life_cells_next[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+life_grid_t life_grid;
+static life_grid_t life_grid_next;
+life_rule_t life_rule = LIFE_RULE;
+uint32_t life_generation = 0;
+
+int cursor_x = 0;
+int cursor_y = 0;
+
+view_t life_view = { .reduce = LIFE_VIEW_REDUCE };
+
+#if LIFE_AGE
+static uint32_t age_cells[LIFE_AGE_BITS * LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+life_age_t life_age;
+// Células acesas no quadro atual do dithering
+static uint32_t dither_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+static life_grid_t dither_grid;
+// Quadros desde o último passo; com life_generation dá a fase do ciclo
+static unsigned frames_since_step;
+#endif
+
+volatile bool life_running = false;
+volatile bool life_dirty = false;
+
+// Padrões via MQTT
+static uint32_t ingest_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+ingest_t life_ingest;
+
+static inline int wrap_x(int v) { return (v + LIFE_GRID_WIDTH) % LIFE_GRID_WIDTH; }
+static inline int wrap_y(int v) { return (v + LIFE_GRID_HEIGHT) % LIFE_GRID_HEIGHT; }
+
+void game_init(void)
+{
+    life_grid_init(&life_grid, life_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&life_grid_next, life_cells_next, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+#if LIFE_AGE
+    life_age_init(&life_age, age_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&dither_grid, dither_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    frames_since_step = 0;
+#endif
+    life_generation = 0;
+    cursor_x = 0;
+    cursor_y = 0;
+    life_view = (view_t){ .reduce = LIFE_VIEW_REDUCE };
+    life_running = false;
+    life_dirty = false;
+    ingest_init(&life_ingest, ingest_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+}
+
+// ---------- Entradas ----------
+
+void game_press_a(void)
+{
+    if (!life_running)
+    {
+        // Toggle célula
+        life_set(&life_grid, cursor_x, cursor_y, !life_get(&life_grid, cursor_x, cursor_y));
+        life_dirty = true;
+    }
+    else
+    {
+        // Rodando: próximo zoom (1x, 2x, 4x, 8x, 1/4, 1/2), mantendo o centro
+        int cx = life_view.x + view_cells_w(&life_view) / 2;
+        int cy = life_view.y + view_cells_h(&life_view) / 2;
+        life_view.zoom = life_view.zoom == VIEW_ZOOM_MAX ? VIEW_ZOOM_MIN : life_view.zoom + 1;
+        life_view.x = cx - view_cells_w(&life_view) / 2;
+        life_view.y = cy - view_cells_h(&life_view) / 2;
+        view_clamp(&life_view, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    }
+}
+
+void game_press_b(void)
+{
+    if (!life_running)
+    {
+        // Começa o Jogo da Vida
+        life_running = true;
+        life_dirty = true;
+    }
+    else
+    {
+        // Reset: volta para desenho
+        life_running = false;
+        life_clear(&life_grid);
+#if LIFE_AGE
+        life_age_clear(&life_age);
+#endif
+        life_generation = 0;
+        life_dirty = true;
+        cursor_x = 0;
+        cursor_y = 0;
+        life_view.x = 0;
+        life_view.y = 0;
+    }
+}
+
+void game_move_cursor(int dx, int dy)
+{
+    if (life_running)
+    {
+        // Rodando: o joystick move a janela, 1/16 da tela por passo
+        int step_x = view_cells_w(&life_view) / 16;
+        int step_y = view_cells_h(&life_view) / 16;
+        view_pan(&life_view, dx * (step_x > 0 ? step_x : 1), dy * (step_y > 0 ? step_y : 1),
+                 LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+        return;
+    }
+    cursor_x = wrap_x(cursor_x + dx);
+    cursor_y = wrap_y(cursor_y + dy);
+    view_follow(&life_view, cursor_x, cursor_y, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+}
+
+// -------- Processar dados recebidos --------
+void game_ingest_begin(uint32_t total_length)
+{
+    ingest_begin(&life_ingest, total_length);
+}
+
+void game_ingest(const uint8_t *data, int len, bool last)
+{
+    ingest_feed(&life_ingest, data, len);
+
+    // Padrão entra inteiro no fim da mensagem, nunca pela metade
+    if (last && ingest_commit(&life_ingest, &life_grid))
+        life_dirty = true;
+}
+
+// ---------- Jogo da Vida ----------
+
+void update_life(void)
+{
+#if LIFE_AGE
+    if (life_rule.states > 2)
+        life_step_gen(&life_grid, &life_grid_next, life_rule, &life_age);
+    else
+        life_step_age(&life_grid, &life_grid_next, life_rule, &life_age);
+    frames_since_step = 0;
+#else
+    life_step(&life_grid, &life_grid_next, life_rule);
+#endif
+    life_copy(&life_grid, &life_grid_next);
+    life_generation++;
+}
+
+// ---------- Renderização ----------
+
+void render_life(uint8_t *buf, const life_grid_t *grid, int ox, int oy, uint32_t now_ms)
+{
+#if LIFE_AGE
+    // Cada chamada é o próximo quadro do ciclo de tons de cinza. A fase parte
+    // de life_generation a cada passo: o primeiro quadro depois do passo (o
+    // que o trace marca com TRACE_FRAME) sai igual no replay, que não vê os
+    // quadros extras entre um passo e outro
+    if (grid == &life_grid)
+    {
+        unsigned frame = life_generation + frames_since_step++;
+        if (life_rule.states > 2)
+            view_dither_gen(&life_grid, &life_age, life_rule.states, frame, &dither_grid);
+        else
+            view_dither_age(&life_grid, &life_age, frame, &dither_grid);
+        grid = &dither_grid;
+    }
+#endif
+
+    // Janela dentro do conteúdo deste tabuleiro (o tile do modo distribuído é menor)
+    view_clamp(&life_view, grid->width - 2 * ox, grid->height - 2 * oy);
+    view_render(&life_view, grid, ox, oy, buf);
+
+    // Cursor piscante se não estiver rodando
+    static bool blink = false;
+    static uint32_t last_blink_ms = 0;
+    if (now_ms - last_blink_ms > 500)
+    {
+        blink = !blink;
+        last_blink_ms = now_ms;
+    }
+    int px, py, size;
+    if (!life_running && blink && view_cell_rect(&life_view, cursor_x, cursor_y, &px, &py, &size))
+        ssd1306_invert_rect(buf, px, py, size, size);
+}
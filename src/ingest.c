@@ -0,0 +1,169 @@
+#include "ingest.h"
+
+// ---------- Staging ----------
+
+static void discard(ingest_t *in)
+{
+    for (int y = in->row_lo; y <= in->row_hi; y++)
+    {
+        uint32_t *row = life_row(&in->staging, y);
+        for (int w = 0; w < in->staging.stride; w++)
+            row[w] = 0;
+    }
+    in->row_lo = in->staging.height;
+    in->row_hi = -1;
+    in->staged = 0;
+    in->open = in->in_number = in->negative = false;
+    in->count = 0;
+    in->value = 0;
+}
+
+static void stage(ingest_t *in, int32_t x, int32_t y)
+{
+    if (x < 0 || x >= in->staging.width || y < 0 || y >= in->staging.height)
+    {
+        in->stats.out_of_range++;
+        return;
+    }
+    uint32_t *word = &life_row(&in->staging, y)[x / LIFE_WORD_BITS];
+    uint32_t bit = 1u << (x % LIFE_WORD_BITS);
+    if (*word & bit)
+        return; // repetida na mesma mensagem
+    *word |= bit;
+    in->staged++;
+    if (y < in->row_lo)
+        in->row_lo = y;
+    if (y > in->row_hi)
+        in->row_hi = y;
+}
+
+// ---------- API ----------
+
+void ingest_init(ingest_t *in, uint32_t *cells, int width, int height)
+{
+    *in = (ingest_t){ 0 };
+    life_grid_init(&in->staging, cells, width, height);
+    in->row_lo = height;
+    in->row_hi = -1;
+}
+
+void ingest_begin(ingest_t *in, uint32_t total_length)
+{
+    if (in->active)
+    {
+        // A anterior nunca recebeu o último pedaço
+        in->stats.dropped++;
+        discard(in);
+    }
+    in->active = true;
+    in->expected = total_length;
+    in->received = 0;
+}
+
+void ingest_feed(ingest_t *in, const uint8_t *data, int len)
+{
+    in->active = true;
+    in->received += len;
+    in->stats.bytes += len;
+
+    // Estado em variáveis locais no laço; volta para a struct no fim
+    bool open = in->open, in_number = in->in_number, negative = in->negative;
+    int count = in->count;
+    int32_t value = in->value;
+
+    for (int i = 0; i < len; i++)
+    {
+        uint8_t c = data[i];
+        uint8_t digit = c - '0';
+        if (digit < 10)
+        {
+            if (open)
+            {
+                if (value < INGEST_MAX_COORD)
+                    value = value * 10 + digit;
+                in_number = true;
+            }
+            continue;
+        }
+
+        if (in_number)
+        {
+            if (count < 2)
+                in->pair[count] = negative ? -value : value;
+            count++;
+            in_number = negative = false;
+            value = 0;
+        }
+
+        switch (c)
+        {
+        case '[':
+            // "[[" do array externo: a tupla começa no último '['
+            open = true;
+            count = 0;
+            negative = false;
+            break;
+        case ']':
+            if (open)
+            {
+                if (count == 2)
+                    stage(in, in->pair[0], in->pair[1]);
+                else if (count)
+                    in->stats.malformed++;
+                open = false;
+            }
+            break;
+        case '-':
+            negative = open;
+            break;
+        case ',':
+        case ' ':
+        case '\t':
+        case '\r':
+        case '\n':
+            break;
+        default:
+            if (open)
+            {
+                in->stats.malformed++;
+                open = false;
+            }
+            break;
+        }
+    }
+
+    in->open = open;
+    in->in_number = in_number;
+    in->negative = negative;
+    in->count = count;
+    in->value = value;
+}
+
+int ingest_commit(ingest_t *in, life_grid_t *dst)
+{
+    if (in->open && (in->count || in->in_number))
+        in->stats.malformed++; // última tupla cortada
+
+    if (in->expected && in->received < in->expected)
+    {
+        in->stats.dropped++;
+        discard(in);
+        in->active = false;
+        return 0;
+    }
+
+    int staged = in->staged;
+    for (int y = in->row_lo; y <= in->row_hi; y++)
+    {
+        const uint32_t *src = life_row(&in->staging, y);
+        uint32_t *row = life_row(dst, y);
+        for (int w = 0; w < in->staging.stride; w++)
+            row[w] |= src[w];
+    }
+    in->stats.messages++;
+    in->stats.cells += staged;
+    discard(in);
+    in->active = false;
+    in->expected = in->received = 0;
+    return staged;
+}
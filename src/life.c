@@ -0,0 +1,370 @@
+#include "life.h"
+#include <string.h>
+#include <stdio.h>
+
+// ---------- Helpers ----------
+
+// Máscara das colunas válidas da palavra w
+static inline uint32_t word_mask(const life_grid_t *grid, int w)
+{
+    int bits = grid->width - w * LIFE_WORD_BITS;
+    return bits >= LIFE_WORD_BITS ? 0xFFFFFFFFu : (1u << bits) - 1u;
+}
+
+static inline uint32_t word_at(const uint32_t *row, int w, int stride)
+{
+    return (row && w >= 0 && w < stride) ? row[w] : 0;
+}
+
+// Soma um plano de vizinhos ao contador bit a bit (s0..s3 = bits 0..3 da contagem)
+static inline void add_plane(uint32_t *s, uint32_t v)
+{
+    uint32_t c0 = s[0] & v;
+    s[0] ^= v;
+    uint32_t c1 = s[1] & c0;
+    s[1] ^= c0;
+    uint32_t c2 = s[2] & c1;
+    s[2] ^= c1;
+    s[3] |= c2;
+}
+
+// Soma os três vizinhos de uma linha: oeste, centro (opcional) e leste
+static inline void add_row(uint32_t *s, const uint32_t *row, int w, int stride, bool center)
+{
+    if (!row)
+        return;
+    uint32_t a = row[w];
+    uint32_t west = (a << 1) | (word_at(row, w - 1, stride) >> 31);
+    uint32_t east = (a >> 1) | (word_at(row, w + 1, stride) << 31);
+    add_plane(s, west);
+    add_plane(s, east);
+    if (center)
+        add_plane(s, a);
+}
+
+// ---------- Grid ----------
+
+void life_grid_init(life_grid_t *grid, uint32_t *cells, int width, int height)
+{
+    grid->width = width;
+    grid->height = height;
+    grid->stride = LIFE_STRIDE(width);
+    grid->cells = cells;
+    life_clear(grid);
+}
+
+void life_clear(life_grid_t *grid)
+{
+    memset(grid->cells, 0, (size_t)grid->height * grid->stride * sizeof(uint32_t));
+}
+
+void life_copy(life_grid_t *dst, const life_grid_t *src)
+{
+    memcpy(dst->cells, src->cells, (size_t)src->height * src->stride * sizeof(uint32_t));
+}
+
+bool life_get(const life_grid_t *grid, int x, int y)
+{
+    if (x < 0 || x >= grid->width || y < 0 || y >= grid->height)
+        return false;
+    return (life_row(grid, y)[x / LIFE_WORD_BITS] >> (x % LIFE_WORD_BITS)) & 1u;
+}
+
+void life_set(life_grid_t *grid, int x, int y, bool on)
+{
+    if (x < 0 || x >= grid->width || y < 0 || y >= grid->height)
+        return;
+    uint32_t *word = &life_row(grid, y)[x / LIFE_WORD_BITS];
+    uint32_t bit = 1u << (x % LIFE_WORD_BITS);
+    if (on) *word |=  bit;
+    else    *word &= ~bit;
+}
+
+int life_population(const life_grid_t *grid)
+{
+    int count = 0;
+    for (int i = 0; i < grid->height * grid->stride; i++)
+        count += __builtin_popcount(grid->cells[i]);
+    return count;
+}
+
+// ---------- Idade ----------
+
+void life_age_init(life_age_t *age, uint32_t *cells, int width, int height)
+{
+    for (int k = 0; k < LIFE_AGE_BITS; k++)
+        life_grid_init(&age->planes[k], cells + (size_t)k * LIFE_GRID_WORDS(width, height), width, height);
+}
+
+void life_age_clear(life_age_t *age)
+{
+    for (int k = 0; k < LIFE_AGE_BITS; k++)
+        life_clear(&age->planes[k]);
+}
+
+int life_age_get(const life_age_t *age, int x, int y)
+{
+    int value = 0;
+    for (int k = 0; k < LIFE_AGE_BITS; k++)
+        value |= life_get(&age->planes[k], x, y) << k;
+    return value;
+}
+
+// ---------- Kernel ----------
+
+// Próxima geração da palavra w da linha mid
+static inline uint32_t step_word(const life_grid_t *cur, const uint32_t *up, const uint32_t *mid,
+                                 const uint32_t *down, int w, life_rule_t rule)
+{
+    const int stride = cur->stride;
+    const uint16_t counts = rule.birth | rule.survive;
+
+    uint32_t s[4] = {0, 0, 0, 0};
+    add_row(s, up, w, stride, true);
+    add_row(s, mid, w, stride, false);
+    add_row(s, down, w, stride, true);
+
+    // Seleciona as contagens presentes na regra
+    uint32_t born = 0, keep = 0;
+    for (int n = 0; n <= 8; n++)
+    {
+        if (!((counts >> n) & 1u))
+            continue;
+        uint32_t eq = ((n & 1) ? s[0] : ~s[0]) & ((n & 2) ? s[1] : ~s[1]) &
+                      ((n & 4) ? s[2] : ~s[2]) & ((n & 8) ? s[3] : ~s[3]);
+        if ((rule.birth >> n) & 1u)
+            born |= eq;
+        if ((rule.survive >> n) & 1u)
+            keep |= eq;
+    }
+
+    uint32_t alive = mid[w];
+    return ((alive & keep) | (~alive & born)) & word_mask(cur, w);
+}
+
+void life_step(const life_grid_t *cur, life_grid_t *next, life_rule_t rule)
+{
+    for (int y = 0; y < cur->height; y++)
+    {
+        const uint32_t *up = y > 0 ? life_row(cur, y - 1) : NULL;
+        const uint32_t *mid = life_row(cur, y);
+        const uint32_t *down = y + 1 < cur->height ? life_row(cur, y + 1) : NULL;
+        uint32_t *out = life_row(next, y);
+
+        for (int w = 0; w < cur->stride; w++)
+            out[w] = step_word(cur, up, mid, down, w, rule);
+    }
+}
+
+void life_step_age(const life_grid_t *cur, life_grid_t *next, life_rule_t rule, life_age_t *age)
+{
+    for (int y = 0; y < cur->height; y++)
+    {
+        const uint32_t *up = y > 0 ? life_row(cur, y - 1) : NULL;
+        const uint32_t *mid = life_row(cur, y);
+        const uint32_t *down = y + 1 < cur->height ? life_row(cur, y + 1) : NULL;
+        uint32_t *out = life_row(next, y);
+        uint32_t *planes[LIFE_AGE_BITS];
+        for (int k = 0; k < LIFE_AGE_BITS; k++)
+            planes[k] = life_row(&age->planes[k], y);
+
+        for (int w = 0; w < cur->stride; w++)
+        {
+            uint32_t alive = step_word(cur, up, mid, down, w, rule);
+            out[w] = alive;
+
+            // Soma 1 nas sobreviventes que não saturaram (contador somador
+            // bit a bit) e zera o resto: quem nasceu começa em 0. Os planos
+            // vão para variáveis locais: out e planes podem apontar para a
+            // mesma memória, e sem isso o compilador relê tudo a cada escrita
+            uint32_t stay = mid[w] & alive;
+            uint32_t p[LIFE_AGE_BITS], full = ~0u;
+            for (int k = 0; k < LIFE_AGE_BITS; k++)
+            {
+                p[k] = planes[k][w];
+                full &= p[k];
+            }
+            uint32_t carry = stay & ~full;
+            for (int k = 0; k < LIFE_AGE_BITS; k++)
+            {
+                planes[k][w] = (p[k] ^ carry) & stay;
+                carry &= p[k];
+            }
+        }
+    }
+}
+
+void life_step_gen(const life_grid_t *cur, life_grid_t *next, life_rule_t rule, life_age_t *dying)
+{
+    // Último valor antes de morrer: estado states - 1
+    const int last = rule.states > 2 ? rule.states - 2 : 0;
+    for (int y = 0; y < cur->height; y++)
+    {
+        const uint32_t *up = y > 0 ? life_row(cur, y - 1) : NULL;
+        const uint32_t *mid = life_row(cur, y);
+        const uint32_t *down = y + 1 < cur->height ? life_row(cur, y + 1) : NULL;
+        uint32_t *out = life_row(next, y);
+        uint32_t *planes[LIFE_AGE_BITS];
+        for (int k = 0; k < LIFE_AGE_BITS; k++)
+            planes[k] = life_row(&dying->planes[k], y);
+
+        for (int w = 0; w < cur->stride; w++)
+        {
+            // Só as mortas contam como morrendo: trocar de life_step_age para
+            // cá deixa idades nas vivas, que não podem virar estados
+            uint32_t p[LIFE_AGE_BITS], old = 0;
+            for (int k = 0; k < LIFE_AGE_BITS; k++)
+            {
+                p[k] = planes[k][w];
+                old |= p[k];
+            }
+            old &= ~mid[w];
+
+            // Quem está morrendo não nasce; as vizinhas são só as vivas
+            uint32_t alive = step_word(cur, up, mid, down, w, rule) & (last ? ~old : ~0u);
+            out[w] = alive;
+
+            // Soma 1 nas que estão morrendo; as que passam de last morrem
+            uint32_t carry = old, past = old;
+            for (int k = 0; k < LIFE_AGE_BITS; k++)
+            {
+                uint32_t bit = p[k];
+                p[k] = (bit ^ carry) & old;
+                carry &= bit;
+                past &= ((last + 1) >> k) & 1 ? p[k] : ~p[k];
+            }
+            // carry: passou de LIFE_AGE_MAX, last + 1 não cabe nos planos
+            uint32_t gone = last ? past | carry : old;
+
+            // A viva que não sobreviveu começa a morrer (valor 1)
+            uint32_t start = last ? mid[w] & ~alive : 0;
+            for (int k = 0; k < LIFE_AGE_BITS; k++)
+                planes[k][w] = (p[k] & ~gone) | (k == 0 ? start : 0);
+        }
+    }
+}
+
+void life_step_batch(const uint32_t *cur, uint32_t *next, int height, int count, life_rule_t rule)
+{
+    // Máscaras por contagem n: s ^ m[n] tem todos os bits em 1 onde a soma é n
+    uint32_t m0[9], m1[9], m2[9], m3[9], bm[9], km[9];
+    for (int n = 0; n <= 8; n++)
+    {
+        m0[n] = (n & 1) ? 0 : ~0u;
+        m1[n] = (n & 2) ? 0 : ~0u;
+        m2[n] = (n & 4) ? 0 : ~0u;
+        m3[n] = (n & 8) ? 0 : ~0u;
+        bm[n] = (rule.birth >> n) & 1u ? ~0u : 0;
+        km[n] = (rule.survive >> n) & 1u ? ~0u : 0;
+    }
+
+    for (int y = 0; y < height; y++)
+    {
+        // Bordas mortas por máscara em vez de if, para o laço não ter desvios
+        const uint32_t *mid = cur + (size_t)y * count;
+        const uint32_t *up = y > 0 ? mid - count : mid;
+        const uint32_t *down = y + 1 < height ? mid + count : mid;
+        const uint32_t up_mask = y > 0 ? ~0u : 0;
+        const uint32_t down_mask = y + 1 < height ? ~0u : 0;
+        uint32_t *out = next + (size_t)y * count;
+
+        // Um universo por u; o laço vira instruções SIMD
+        for (int u = 0; u < count; u++)
+        {
+            uint32_t s[4] = {0, 0, 0, 0};
+            uint32_t a = mid[u];
+            uint32_t b = up[u] & up_mask;
+            uint32_t c = down[u] & down_mask;
+            add_plane(s, a << 1);
+            add_plane(s, a >> 1);
+            add_plane(s, b << 1);
+            add_plane(s, b >> 1);
+            add_plane(s, b);
+            add_plane(s, c << 1);
+            add_plane(s, c >> 1);
+            add_plane(s, c);
+
+            uint32_t born = 0, keep = 0;
+            for (int n = 0; n <= 8; n++)
+            {
+                uint32_t eq = (s[0] ^ m0[n]) & (s[1] ^ m1[n]) & (s[2] ^ m2[n]) & (s[3] ^ m3[n]);
+                born |= eq & bm[n];
+                keep |= eq & km[n];
+            }
+            out[u] = (a & keep) | (~a & born);
+        }
+    }
+}
+
+uint32_t life_checksum(const life_grid_t *grid)
+{
+    uint32_t h = 2166136261u;
+    h = (h ^ grid->width) * 16777619u;
+    h = (h ^ grid->height) * 16777619u;
+    for (int i = 0; i < grid->height * grid->stride; i++)
+        h = (h ^ grid->cells[i]) * 16777619u;
+    return h;
+}
+
+int life_format_rule(life_rule_t rule, char *buf, size_t size)
+{
+    char tmp[LIFE_RULE_TEXT_MAX];
+    int len = 0;
+    tmp[len++] = 'B';
+    for (int n = 0; n <= 8; n++)
+        if ((rule.birth >> n) & 1u)
+            tmp[len++] = '0' + n;
+    tmp[len++] = '/';
+    tmp[len++] = 'S';
+    for (int n = 0; n <= 8; n++)
+        if ((rule.survive >> n) & 1u)
+            tmp[len++] = '0' + n;
+    if (rule.states > 2)
+        len += snprintf(tmp + len, sizeof(tmp) - len, "/C%d", rule.states);
+    tmp[len] = '\0';
+    return snprintf(buf, size, "%s", tmp);
+}
+
+// "B3/S23" (como o frontend) ou a notação antiga "23/3" (sobrevive/nasce);
+// Generations com uma terceira parte, o número de estados: "B2/S/C3", "/2/3"
+bool life_parse_rule(const char *text, life_rule_t *rule)
+{
+    uint16_t masks[2] = {0, 0};
+    int part = 0, states = 0;
+    bool bs = false;
+    const char *p = text;
+    while (*p == ' ')
+        p++;
+    if (*p == 'B' || *p == 'b')
+    {
+        bs = true;
+        p++;
+    }
+    for (; *p && *p != ' ' && *p != '\r' && *p != '\n'; p++)
+    {
+        if (part == 2 && *p >= '0' && *p <= '9')
+        {
+            states = states * 10 + (*p - '0');
+            if (states > LIFE_GEN_STATES_MAX)
+                return false;
+        }
+        else if (part < 2 && *p >= '0' && *p <= '8')
+            masks[part] |= 1u << (*p - '0');
+        else if (*p == '/' && part < 2)
+        {
+            part++;
+            if (part == 1 && bs && (p[1] == 'S' || p[1] == 's'))
+                p++;
+            else if (part == 2 && (p[1] == 'C' || p[1] == 'c'))
+                p++;
+        }
+        else
+            return false;
+    }
+    if (part == 0 || (part == 2 && states < 2))
+        return false;
+    rule->birth = bs ? masks[0] : masks[1];
+    rule->survive = bs ? masks[1] : masks[0];
+    rule->states = states > 2 ? states : 0;
+    return true;
+}
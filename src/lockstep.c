@@ -0,0 +1,129 @@
+#include "lockstep.h"
+#include <stdio.h>
+#include <string.h>
+
+#define LOCKSTEP_MAX_STRIDE 8 // até 256 colunas
+#define LOCKSTEP_MAX_HEIGHT 128
+
+static const life_grid_t *live_grid;
+static const life_rule_t *live_rule;
+static const uint32_t *live_generation;
+
+// Cópia do tabuleiro enviada como semente; o jogo continua rodando enquanto
+// as linhas são publicadas e os clientes alcançam pelos ticks depois
+static uint32_t snapshot_cells[LOCKSTEP_MAX_HEIGHT * LOCKSTEP_MAX_STRIDE];
+static life_grid_t snapshot;
+static uint32_t snapshot_gen;
+
+static bool seed_pending = false;
+static int seed_row = -1; // -1 = cabeçalho; height = mensagem de fim
+static bool seeding = false;
+static uint32_t last_tick_gen = 0;
+
+void lockstep_init(const life_grid_t *grid, const life_rule_t *rule, const uint32_t *generation)
+{
+    if (grid->stride > LOCKSTEP_MAX_STRIDE || grid->height > LOCKSTEP_MAX_HEIGHT)
+    {
+        printf("❌ Lockstep: tabuleiro grande demais para a semente\n");
+        return;
+    }
+    if (rule->states > 2)
+    {
+        // A semente só leva as vivas; o frontend não teria os estados
+        printf("❌ Lockstep: regra Generations, o frontend não acompanha\n");
+        return;
+    }
+    live_grid = grid;
+    live_rule = rule;
+    live_generation = generation;
+    life_grid_init(&snapshot, snapshot_cells, grid->width, grid->height);
+    seed_pending = true;
+}
+
+void lockstep_request_seed(void)
+{
+    seed_pending = true;
+}
+
+static bool publish(mqtt_client_t *client, const char *msg, int len)
+{
+    return mqtt_publish(client, LOCKSTEP_TOPIC, msg, len, 0, 0, NULL, NULL) == ERR_OK;
+}
+
+// Publica a próxima parte da semente; false se o MQTT ainda não tem espaço
+static bool publish_seed_part(mqtt_client_t *client)
+{
+    char msg[16 + LOCKSTEP_SEED_ROWS * LOCKSTEP_MAX_STRIDE * 8];
+    int len;
+
+    if (seed_row < 0)
+    {
+        char rule[LIFE_RULE_TEXT_MAX];
+        life_format_rule(*live_rule, rule, sizeof(rule));
+        len = snprintf(msg, sizeof(msg), "H %lu %d %d %s", (unsigned long)snapshot_gen,
+                       snapshot.width, snapshot.height, rule);
+        if (!publish(client, msg, len))
+            return false;
+        seed_row = 0;
+    }
+    else if (seed_row < snapshot.height)
+    {
+        len = snprintf(msg, sizeof(msg), "S %d ", seed_row);
+        for (int y = seed_row; y < seed_row + LOCKSTEP_SEED_ROWS && y < snapshot.height; y++)
+        {
+            const uint32_t *row = life_row(&snapshot, y);
+            for (int w = 0; w < snapshot.stride; w++)
+                len += snprintf(msg + len, sizeof(msg) - len, "%08lx", (unsigned long)row[w]);
+        }
+        if (!publish(client, msg, len))
+            return false;
+        seed_row += LOCKSTEP_SEED_ROWS;
+    }
+    else
+    {
+        len = snprintf(msg, sizeof(msg), "E %lu %08lx", (unsigned long)snapshot_gen,
+                       (unsigned long)life_checksum(&snapshot));
+        if (!publish(client, msg, len))
+            return false;
+        seeding = false;
+        last_tick_gen = snapshot_gen;
+    }
+    return true;
+}
+
+void lockstep_poll(mqtt_client_t *client)
+{
+    if (!live_grid || !client || !mqtt_client_is_connected(client))
+        return;
+
+    if (seed_pending)
+    {
+        life_copy(&snapshot, live_grid);
+        snapshot_gen = *live_generation;
+        seed_pending = false;
+        seeding = true;
+        seed_row = -1;
+    }
+
+    // Envia quantas partes couberem; o resto sai no próximo poll
+    while (seeding)
+    {
+        if (!publish_seed_part(client))
+            return;
+    }
+
+    uint32_t gen = *live_generation;
+    if (gen == last_tick_gen)
+        return;
+
+    char msg[32];
+    int len;
+    if (gen % LOCKSTEP_CHECK_EVERY == 0)
+        len = snprintf(msg, sizeof(msg), "T %lu %08lx", (unsigned long)gen,
+                       (unsigned long)life_checksum(live_grid));
+    else
+        len = snprintf(msg, sizeof(msg), "T %lu", (unsigned long)gen);
+
+    if (publish(client, msg, len))
+        last_tick_gen = gen;
+}
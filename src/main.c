@@ -4,7 +4,15 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "hardware/adc.h"
+#include "hardware/sync.h"
+#include "hardware/flash.h"
+#include "pico/flash.h"
 #include "ssd1306.h"
+#include "life.h"
+#include "game.h"
+#include "trace.h"
+#include "lockstep.h"
+#include "dist.h"
 #include "pico/cyw43_arch.h"
 #include "lwip/apps/mqtt.h"
 #include "lwip/ip_addr.h"
@@ -22,29 +30,64 @@
 #define LED_R_PIN 13
 #define LED_G_PIN 11
 
-#define LIFE_RENDER_WIDTH ssd1306_width   // 128
-#define LIFE_RENDER_HEIGHT ssd1306_height // 64
-
-#define LIFE_GRID_WIDTH 136 // tabuleiro maior que render
-#define LIFE_GRID_HEIGHT 72
-
 // --- Config WiFi + MQTT ---
 
 #define WIFI_SSID "brisa-4370576"
 #define WIFI_PASSWORD "mmy6opmr"
 #define MQTT_BROKER "52.57.135.186"
 #define MQTT_TOPIC "pico/life"
-#define REST_BUFFER_SIZE 64
 
-// ---------- Variáveis globais ----------
+// --- Modo distribuído: vários Picos, cada um dono de um tile 128x64 ---
+
+#ifndef LIFE_DIST
+#define LIFE_DIST 0
+#endif
+#ifndef DIST_NODE_COL
+#define DIST_NODE_COL 0 // posição deste Pico na malha
+#endif
+#ifndef DIST_NODE_ROW
+#define DIST_NODE_ROW 0
+#endif
+#ifndef DIST_NODE_COLS
+#define DIST_NODE_COLS 2 // tamanho da malha
+#endif
+#ifndef DIST_NODE_ROWS
+#define DIST_NODE_ROWS 1
+#endif
+
+// --- Gravação/replay das entradas (ver trace.h e tools/replay.c) ---
+
+#define TRACE_OFF 0
+#define TRACE_RECORD_USB 1   // linhas "TRACE <hex>" no stdio USB
+#define TRACE_RECORD_FLASH 2 // no fim da flash; tirar com picotool save
+#define TRACE_REPLAY_FLASH 3 // roda o trace gravado na flash no lugar das entradas
 
-bool life_grid[LIFE_GRID_WIDTH][LIFE_GRID_HEIGHT];
-bool life_grid_next[LIFE_GRID_WIDTH][LIFE_GRID_HEIGHT];
+#ifndef TRACE_MODE
+#define TRACE_MODE TRACE_OFF
+#endif
+#define TRACE_RECORDING (TRACE_MODE == TRACE_RECORD_USB || TRACE_MODE == TRACE_RECORD_FLASH)
+#define TRACE_FLASH_SIZE (256 * 1024)
+#define TRACE_FLASH_OFFSET (PICO_FLASH_SIZE_BYTES - TRACE_FLASH_SIZE)
+#define TRACE_FLASH_SYNC_MS 1000 // página incompleta vai para a flash a cada tanto
 
-int cursor_x = 0;
-int cursor_y = 0;
+// --- Relatório da recepção de padrões (ver ingest.h) ---
 
-bool life_running = false;
+#define INGEST_REPORT_MS 5000 // 0 desliga
+
+// --- Laço principal: um passo a cada LIFE_STEP_MS; no modo idade (LIFE_AGE
+// em game.h) quadros do dithering no intervalo ---
+
+#define LIFE_STEP_MS 50
+#define DISPLAY_REPORT_MS 5000
+
+#define STR_(x) #x
+#define STR(x) STR_(x)
+
+// ---------- Variáveis globais ----------
+
+#if LIFE_DIST
+static dist_node_t dist_node;
+#endif
 
 // SSD1306 buffer
 uint8_t ssd[ssd1306_buffer_length];
@@ -53,58 +96,238 @@ struct render_area frame_area;
 volatile uint64_t last_press_time_a = 0;
 volatile uint64_t last_press_time_b = 0;
 
-// ---------- Joystick & Botões ----------
+// Botões: o IRQ só enfileira, o loop aplica (e grava) entre dois passos.
+// Aplicar no IRQ podia cair no meio de update_life() e o trace gravaria uma
+// ordem diferente da executada. Um produtor (IRQ) e um consumidor (loop).
+#define BUTTON_QUEUE_LEN 8 // potência de 2
+static volatile uint8_t button_queue[BUTTON_QUEUE_LEN];
+static volatile uint32_t button_head = 0; // escrito só pelo IRQ
+static volatile uint32_t button_tail = 0; // escrito só pelo loop
 
-static inline int wrap_x(int v) { return (v + LIFE_GRID_WIDTH) % LIFE_GRID_WIDTH; }
-static inline int wrap_y(int v) { return (v + LIFE_GRID_HEIGHT) % LIFE_GRID_HEIGHT; }
+#if TRACE_RECORDING
+static trace_writer_t trace_writer;
+static uint32_t trace_start_ms = 0;
+#endif
 
 // Cliente MQTT
 mqtt_client_t *mqtt_client;
 
 // Info MQTT
 static const struct mqtt_connect_client_info_t mqtt_client_info = {
+#if LIFE_DIST
+    .client_id = "PicoLife-" STR(DIST_NODE_COL) "-" STR(DIST_NODE_ROW),
+#else
     .client_id = "PicoLife",
+#endif
     .keep_alive = 60,
 };
-// Buffer MQTT
-static char rest_buffer[REST_BUFFER_SIZE];
-static int rest_len = 0;
+// Tópico da mensagem sendo recebida
+typedef enum
+{
+    INCOMING_PATTERN,
+    INCOMING_RESYNC, // pedido de ressincronização do lockstep
+    INCOMING_HALO,   // borda de um vizinho no modo distribuído
+} incoming_kind_t;
+static incoming_kind_t incoming_kind = INCOMING_PATTERN;
+
+// Tempo gasto no parser dos padrões, para o relatório
+static uint64_t ingest_busy_us = 0;
+
+// Quadros enviados ao display, para o relatório do modo idade
+static uint32_t display_frames = 0;
+
+// ---------- Gravação de entradas ----------
+
+// Registra uma entrada; chamado do loop e dos callbacks lwIP
+static void record(trace_event_t ev)
+{
+#if TRACE_RECORDING
+    uint32_t irq = save_and_disable_interrupts();
+    ev.time_ms = to_ms_since_boot(get_absolute_time()) - trace_start_ms;
+    trace_write(&trace_writer, &ev);
+    restore_interrupts(irq);
+#else
+    (void)ev;
+#endif
+}
+
+#if TRACE_MODE == TRACE_RECORD_FLASH
+static uint8_t flash_page[FLASH_PAGE_SIZE];
+static int flash_page_len = 0;
+static int flash_page_synced = 0;  // bytes da página atual já na flash
+static uint32_t flash_written = 0; // páginas completas já gravadas, em bytes
+static bool flash_full = false;
+
+static void program_page(void *param)
+{
+    (void)param;
+    // O setor é apagado na primeira gravação da sua primeira página. Regravar
+    // a página com mais bytes só zera bits que a sobra em 0xFF deixou em 1
+    if (flash_written % FLASH_SECTOR_SIZE == 0 && flash_page_synced == 0)
+        flash_range_erase(TRACE_FLASH_OFFSET + flash_written, FLASH_SECTOR_SIZE);
+    flash_range_program(TRACE_FLASH_OFFSET + flash_written, flash_page, FLASH_PAGE_SIZE);
+}
+
+// Grava a página atual com o resto em 0xFF, que lê como TRACE_END
+static void sync_page(void)
+{
+    if (flash_page_len == flash_page_synced)
+        return;
+    memset(flash_page + flash_page_len, 0xFF, FLASH_PAGE_SIZE - flash_page_len);
+    flash_safe_execute(program_page, NULL, 100);
+    flash_page_synced = flash_page_len;
+}
+
+static void flash_append(const uint8_t *data, int len)
+{
+    for (int i = 0; i < len; i++)
+    {
+        flash_page[flash_page_len++] = data[i];
+        if (flash_page_len == FLASH_PAGE_SIZE)
+        {
+            sync_page();
+            flash_written += FLASH_PAGE_SIZE;
+            flash_page_len = flash_page_synced = 0;
+        }
+    }
+}
+#endif
+
+// Descarrega o que foi gravado: fora de IRQ, no loop principal
+static void flush_trace(void)
+{
+#if TRACE_RECORDING
+    static uint8_t pending[TRACE_BUFFER_SIZE];
+    static uint32_t reported = 0;
+    uint32_t irq = save_and_disable_interrupts();
+    int n = trace_take(&trace_writer, pending, sizeof(pending));
+    uint32_t dropped = trace_writer.dropped;
+    restore_interrupts(irq);
+
+    if (dropped != reported)
+    {
+        // O trace também marca o buraco (TRACE_DROPPED); aqui é para quem grava ver na hora
+        printf("⚠️ Trace: %lu eventos perdidos com o buffer cheio (%lu no total)\n",
+               (unsigned long)(dropped - reported), (unsigned long)dropped);
+        reported = dropped;
+    }
+
+#if TRACE_MODE == TRACE_RECORD_USB
+    for (int i = 0; i < n; i += 32)
+    {
+        printf("TRACE ");
+        for (int j = i; j < n && j < i + 32; j++)
+            printf("%02x", pending[j]);
+        printf("\n");
+    }
+#else
+    // Evento por evento, para nunca cortar um no meio e sempre sobrar lugar
+    // para o TRACE_TRUNCATED
+    trace_reader_t events = { .data = pending, .len = n };
+    if (flash_written == 0 && flash_page_len == 0)
+    {
+        flash_append(pending, TRACE_HEADER_LEN); // primeira descarga: começa pelo cabeçalho
+        events.pos = TRACE_HEADER_LEN;
+    }
+    trace_event_t ev;
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+    while (!flash_full && events.pos < events.len)
+    {
+        size_t start = events.pos;
+        if (!trace_next(&events, &ev))
+            break;
+        size_t len = events.pos - start;
+        if (flash_written + flash_page_len + len + TRACE_TRUNCATED_LEN > TRACE_FLASH_SIZE)
+        {
+            uint8_t mark[TRACE_TRUNCATED_LEN];
+            flash_append(mark, trace_truncated(mark));
+            sync_page();
+            flash_full = true;
+            printf("⚠️ Trace: flash cheia, gravação parou em t=%lu ms\n",
+                   (unsigned long)(now_ms - trace_start_ms));
+            break;
+        }
+        flash_append(pending + start, len);
+    }
+
+    // A página incompleta não espera encher: um reset perderia o fim da sessão
+    static uint32_t last_sync_ms = 0;
+    if (!flash_full && now_ms - last_sync_ms >= TRACE_FLASH_SYNC_MS)
+    {
+        sync_page();
+        last_sync_ms = now_ms;
+    }
+#endif
+#endif
+}
+
+// ---------- Joystick & Botões ----------
+
+// Verde = desenhando, apagado = rodando
+static void update_leds(void)
+{
+    gpio_put(LED_R_PIN, 0);
+    gpio_put(LED_G_PIN, life_running ? 0 : 1);
+}
+
+// Efeito de um botão (TRACE_BTN_A / TRACE_BTN_B), ao vivo ou no replay
+static void apply_button(uint8_t type)
+{
+    if (type == TRACE_BTN_A)
+    {
+        game_press_a();
+        return;
+    }
+    game_press_b();
+#if LIFE_DIST
+    if (life_running)
+        dist_node_load(&dist_node, &life_grid, 0, 0);
+#endif
+    update_leds();
+}
 
 void gpio_callback(uint gpio, uint32_t events)
 {
+#if TRACE_MODE == TRACE_REPLAY_FLASH
+    // Entradas vêm do trace
+    (void)gpio;
+    (void)events;
+#else
     uint64_t current_time = to_ms_since_boot(get_absolute_time());
 
+    uint8_t type;
     if (gpio == BTN_A_PIN && current_time - last_press_time_a > 200) // 200ms debounce
     {
         last_press_time_a = current_time;
-
-        if (!life_running)
-        {
-            // Toggle célula
-            life_grid[cursor_x][cursor_y] = !life_grid[cursor_x][cursor_y];
-        }
+        type = TRACE_BTN_A;
     }
     else if (gpio == BTN_B_PIN && current_time - last_press_time_b > 200) // 200ms debounce
     {
         last_press_time_b = current_time;
+        type = TRACE_BTN_B;
+    }
+    else
+    {
+        return;
+    }
 
-        if (!life_running)
-        {
-            // Começa o Jogo da Vida
-            life_running = true;
-            gpio_put(LED_R_PIN, 0);
-            gpio_put(LED_G_PIN, 0);
-        }
-        else
-        {
-            // Reset: volta para desenho
-            life_running = false;
-            memset(life_grid, 0, sizeof(life_grid));
-            cursor_x = 0;
-            cursor_y = 0;
-            gpio_put(LED_R_PIN, 0);
-            gpio_put(LED_G_PIN, 1);
-        }
+    if (button_head - button_tail < BUTTON_QUEUE_LEN) // cheia: perde o aperto
+    {
+        button_queue[button_head % BUTTON_QUEUE_LEN] = type;
+        button_head++;
+    }
+#endif
+}
+
+// Aplica os apertos enfileirados pelo IRQ, na ordem em que chegaram
+void handle_buttons(void)
+{
+    while (button_tail != button_head)
+    {
+        uint8_t type = button_queue[button_tail % BUTTON_QUEUE_LEN];
+        button_tail++;
+        record((trace_event_t){ .type = type });
+        apply_button(type);
     }
 }
 
@@ -136,70 +359,27 @@ void handle_joystick(void)
     if (!dx && !dy)
         return;
 
-    cursor_x = wrap_x(cursor_x + dx);
-    cursor_y = wrap_y(cursor_y + dy);
+    record((trace_event_t){ .type = TRACE_MOVE, .dx = dx, .dy = dy });
+    game_move_cursor(dx, dy);
 
     last_move_ms = now_ms;
 }
 
-// ---------- Jogo da Vida ----------
-
-void update_life(void)
-{
-    for (int x = 0; x < LIFE_GRID_WIDTH; x++)
-    {
-        for (int y = 0; y < LIFE_GRID_HEIGHT; y++)
-        {
-            int neighbors = 0;
-            for (int dx = -1; dx <= 1; dx++)
-            {
-                for (int dy = -1; dy <= 1; dy++)
-                {
-                    if (dx == 0 && dy == 0)
-                        continue;
-                    int nx = x + dx;
-                    int ny = y + dy;
-                    if (nx >= 0 && nx < LIFE_GRID_WIDTH && ny >= 0 && ny < LIFE_GRID_HEIGHT)
-                        neighbors += life_grid[nx][ny] ? 1 : 0;
-                }
-            }
-            if (life_grid[x][y])
-                life_grid_next[x][y] = (neighbors == 2 || neighbors == 3);
-            else
-                life_grid_next[x][y] = (neighbors == 3);
-        }
-    }
-    memcpy(life_grid, life_grid_next, sizeof(life_grid));
-}
-
 // ---------- Renderização ----------
 
-void render_life(void)
+void render_frame(void)
 {
-    ssd1306_clear(ssd);
-
-    // Render apenas o retângulo visível do tabuleiro
-    for (int x = 0; x < LIFE_RENDER_WIDTH; x++)
-        for (int y = 0; y < LIFE_RENDER_HEIGHT; y++)
-            if (life_grid[x][y])
-                ssd1306_set_pixel(ssd, x, y, true);
-
-    // Cursor piscante se não estiver rodando
-    static bool blink = false;
-    static uint64_t last_blink_ms = 0;
-    uint64_t now_ms = to_ms_since_boot(get_absolute_time());
-    if (now_ms - last_blink_ms > 500)
-    {
-        blink = !blink;
-        last_blink_ms = now_ms;
-    }
-    if (!life_running && blink)
-    {
-        if (cursor_x < LIFE_RENDER_WIDTH && cursor_y < LIFE_RENDER_HEIGHT)
-            ssd1306_set_pixel(ssd, cursor_x, cursor_y, true);
-    }
-
-    render_on_display(ssd, &frame_area);
+    uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+#if LIFE_DIST
+    if (life_running)
+        render_life(ssd, &dist_node.grid, 1, 1, now_ms);
+    else
+        render_life(ssd, &life_grid, 0, 0, now_ms);
+#else
+    render_life(ssd, &life_grid, 0, 0, now_ms);
+#endif
+    render_on_display_changes(ssd, &frame_area);
+    display_frames++;
 }
 
 // ---------- Inicialização ----------
@@ -274,6 +454,10 @@ void mqtt_connection_cb(mqtt_client_t *client, void *arg,
 
         // Se inscreve para receber updates
         mqtt_subscribe(client, MQTT_TOPIC, 1, mqtt_subscription_cb, NULL);
+        mqtt_subscribe(client, LOCKSTEP_RESYNC_TOPIC, 0, mqtt_subscription_cb, NULL);
+#if LIFE_DIST
+        mqtt_subscribe(client, DIST_HALO_TOPIC "/+", 0, mqtt_subscription_cb, NULL);
+#endif
 
         gpio_put(LED_G_PIN, 1); // green = connected
         gpio_put(LED_R_PIN, 0);
@@ -289,88 +473,68 @@ void mqtt_connection_cb(mqtt_client_t *client, void *arg,
 // -------- Mensagem chegando --------
 void mqtt_incoming_publish_cb(void *arg, const char *topic, u32_t total_length)
 {
-    printf("📩 Incoming message on topic: %s, length: %d\n", topic, total_length);
+    // Sem printf aqui: com padrões grandes chegando em sequência, o stdio
+    // custa mais que o parser
+    if (strcmp(topic, LOCKSTEP_RESYNC_TOPIC) == 0)
+        incoming_kind = INCOMING_RESYNC;
+    else if (strncmp(topic, DIST_HALO_TOPIC "/", sizeof(DIST_HALO_TOPIC)) == 0)
+        incoming_kind = INCOMING_HALO;
+    else
+    {
+        incoming_kind = INCOMING_PATTERN;
+#if TRACE_MODE != TRACE_REPLAY_FLASH
+        record((trace_event_t){ .type = TRACE_MQTT_BEGIN, .total_length = total_length });
+        game_ingest_begin(total_length);
+#endif
+    }
 }
 
 // -------- Processar dados recebidos --------
 void mqtt_incoming_data_cb(void *arg, const u8_t *data, u16_t len, u8_t flags)
 {
-    // Buffer temporário para concatenar resto + novo chunk
-    static char chunk_buffer[REST_BUFFER_SIZE + 512]; // ajusta 512 p/ maior chunk esperado
-    int total_len = 0;
-
-    // Copia o resto não processado do chunk anterior
-    if (rest_len > 0)
+    // Cliente web fora de sincronia: reenvia a semente
+    if (incoming_kind == INCOMING_RESYNC)
     {
-        memcpy(chunk_buffer, rest_buffer, rest_len);
-        total_len = rest_len;
-        rest_len = 0;
-    }
-
-    // Adiciona o novo chunk
-    if (len + total_len < sizeof(chunk_buffer))
-    {
-        memcpy(chunk_buffer + total_len, data, len);
-        total_len += len;
-        chunk_buffer[total_len] = '\0';
-    }
-    else
-    {
-        // Se chunk maior que buffer (raro), descarta para evitar overflow
-        printf("Chunk grande demais, descartado!\n");
+        if (flags & MQTT_DATA_FLAG_LAST)
+            lockstep_request_seed();
         return;
     }
 
-    // ---- Processa coordenadas completas ----
-    char *ptr = chunk_buffer;
-    while (1)
+#if LIFE_DIST
+    // Halo de um vizinho: junta os pedaços e entrega inteiro ao nó
+    if (incoming_kind == INCOMING_HALO)
     {
-        char *open = strchr(ptr, '[');
-        if (!open)
-            break;
-
-        char *close = strchr(open, ']');
-        if (!close)
+        static uint8_t halo_buffer[DIST_HALO_MAX];
+        static int halo_len = 0;
+        if (halo_len + len <= DIST_HALO_MAX)
+            memcpy(halo_buffer + halo_len, data, len);
+        halo_len += len;
+        if (flags & MQTT_DATA_FLAG_LAST)
         {
-            // Faltou fechar, salva no resto para próximo chunk
-            int remaining = strlen(open);
-            if (remaining < REST_BUFFER_SIZE)
-            {
-                memcpy(rest_buffer, open, remaining);
-                rest_len = remaining;
-            }
-            else
-            {
-                printf("Resto grande demais, descartado!\n");
-                rest_len = 0;
-            }
-            break;
+            if (halo_len <= DIST_HALO_MAX)
+                dist_node_on_message(&dist_node, halo_buffer, halo_len);
+            halo_len = 0;
         }
-
-        // Temos "[x,y]" completo
-        int x, y;
-        if (sscanf(open, "[%d,%d]", &x, &y) == 2)
-        {
-            if (x >= 0 && x < LIFE_GRID_WIDTH &&
-                y >= 0 && y < LIFE_GRID_HEIGHT)
-            {
-                life_grid[x][y] = true;
-
-                // Aqui pode chamar função para renderizar pixel direto:
-                ssd1306_set_pixel(ssd, x, y, true);
-            }
-        }
-
-        // Continua a partir do próximo caractere após o ']'
-        ptr = close + 1;
+        return;
     }
+#endif
+
+#if TRACE_MODE != TRACE_REPLAY_FLASH // no replay os padrões vêm do trace
+    record((trace_event_t){ .type = TRACE_MQTT, .data = data, .len = len,
+                            .last = (flags & MQTT_DATA_FLAG_LAST) != 0 });
+    uint64_t start = time_us_64();
+    game_ingest(data, len, flags & MQTT_DATA_FLAG_LAST);
+    ingest_busy_us += time_us_64() - start;
+#endif
+}
 
-    // Quando for o último fragmento da mensagem, podemos limpar o resto
-    if (flags & MQTT_DATA_FLAG_LAST)
-    {
-        rest_len = 0;
-    }
+#if LIFE_DIST
+// -------- Transporte do modo distribuído --------
+static bool dist_publish(void *ctx, const char *topic, const uint8_t *payload, int len)
+{
+    return mqtt_publish((mqtt_client_t *)ctx, topic, payload, len, 0, 0, NULL, NULL) == ERR_OK;
 }
+#endif
 
 // -------- Inicialização MQTT --------
 void init_mqtt()
@@ -442,12 +606,149 @@ void init_oled_display(void)
     render_on_display(ssd, &frame_area);
 }
 
+#if TRACE_MODE == TRACE_REPLAY_FLASH
+// ---------- Replay ----------
+
+// Aplica as entradas de uma volta do loop; false no fim do trace
+static bool replay_frame(trace_reader_t *reader, bool *stepped)
+{
+    trace_event_t ev;
+    while (trace_next(reader, &ev))
+    {
+        switch (ev.type)
+        {
+        case TRACE_FRAME:
+            *stepped = ev.stepped;
+            return true;
+        case TRACE_BTN_A:
+        case TRACE_BTN_B:
+            apply_button(ev.type);
+            break;
+        case TRACE_MOVE:
+            game_move_cursor(ev.dx, ev.dy);
+            break;
+        case TRACE_MQTT_BEGIN:
+            game_ingest_begin(ev.total_length);
+            break;
+        case TRACE_MQTT:
+            game_ingest(ev.data, ev.len, ev.last);
+            break;
+        case TRACE_DROPPED:
+            printf("⚠️ Replay: %lu eventos perdidos na gravação em t=%lu ms, daqui em diante diverge\n",
+                   (unsigned long)ev.count, (unsigned long)ev.time_ms);
+            break;
+        case TRACE_TRUNCATED:
+            printf("⚠️ Replay: a gravação parou em t=%lu ms com a flash cheia\n", (unsigned long)ev.time_ms);
+            return false;
+        }
+    }
+    return false;
+}
+
+// Roda o trace da flash no lugar das entradas e mede cada quadro
+static void run_replay(void)
+{
+    trace_reader_t reader;
+    if (!trace_reader_init(&reader, (const uint8_t *)(XIP_BASE + TRACE_FLASH_OFFSET), TRACE_FLASH_SIZE))
+    {
+        printf("❌ Nenhum trace na flash\n");
+        return;
+    }
+
+    uint32_t frame = 0;
+    bool stepped;
+    uint64_t total_us = 0, worst_us = 0;
+    while (replay_frame(&reader, &stepped))
+    {
+        uint64_t start = time_us_64();
+        if (stepped)
+            update_life();
+        render_frame();
+        uint64_t us = time_us_64() - start;
+
+        printf("FRAME %lu %lu\n", (unsigned long)frame, (unsigned long)us);
+        total_us += us;
+        if (us > worst_us)
+            worst_us = us;
+        frame++;
+        sleep_ms(50);
+    }
+    printf("Replay: %lu quadros, média %lu us, pior %lu us, checksum %08lx\n", (unsigned long)frame,
+           (unsigned long)(frame ? total_us / frame : 0), (unsigned long)worst_us,
+           (unsigned long)life_checksum(&life_grid));
+}
+#endif
+
+// ---------- Relatório da recepção ----------
+
+// A cada INGEST_REPORT_MS, se chegou algum padrão: vazão no intervalo e
+// descartes acumulados
+static void report_ingest(uint32_t now_ms)
+{
+#if INGEST_REPORT_MS
+    static uint32_t last_ms = 0;
+    static ingest_stats_t last;
+    static uint64_t last_busy_us = 0;
+    uint32_t elapsed_ms = now_ms - last_ms;
+    if (elapsed_ms < INGEST_REPORT_MS)
+        return;
+
+    const ingest_stats_t *s = &life_ingest.stats;
+    if (s->bytes != last.bytes)
+    {
+        uint64_t bytes = s->bytes - last.bytes, cells = s->cells - last.cells;
+        uint64_t busy_us = ingest_busy_us - last_busy_us;
+        printf("📥 %lu msgs, %lu B/s, %lu células/s, parser %lu us (%lu B/ms), "
+               "descartadas %lu, fora %lu, inválidas %lu\n",
+               (unsigned long)(s->messages - last.messages),
+               (unsigned long)(bytes * 1000 / elapsed_ms), (unsigned long)(cells * 1000 / elapsed_ms),
+               (unsigned long)busy_us, (unsigned long)(busy_us ? bytes * 1000 / busy_us : 0),
+               (unsigned long)s->dropped, (unsigned long)s->out_of_range, (unsigned long)s->malformed);
+    }
+    last = *s;
+    last_busy_us = ingest_busy_us;
+    last_ms = now_ms;
+#else
+    (void)now_ms;
+#endif
+}
+
+// A cada DISPLAY_REPORT_MS no modo idade: quadros por segundo e bytes de I2C
+// por quadro, que limitam quantos tons de cinza o dithering mostra sem piscar
+static void report_display(uint32_t now_ms)
+{
+#if LIFE_AGE
+    static uint32_t last_ms = 0, last_frames = 0, last_bytes = 0;
+    uint32_t elapsed_ms = now_ms - last_ms;
+    if (elapsed_ms < DISPLAY_REPORT_MS)
+        return;
+
+    uint32_t frames = display_frames - last_frames, bytes = ssd1306_i2c_bytes - last_bytes;
+    printf("🎞️ %lu quadros/s, %lu bytes I2C por quadro, ciclo de cinza %lu ms\n",
+           (unsigned long)(frames * 1000 / elapsed_ms), (unsigned long)(frames ? bytes / frames : 0),
+           (unsigned long)(frames ? VIEW_GREY_FRAMES * elapsed_ms / frames : 0));
+    last_frames = display_frames;
+    last_bytes = ssd1306_i2c_bytes;
+    last_ms = now_ms;
+#else
+    (void)now_ms;
+#endif
+}
+
 // ---------- Main ----------
 
 int main()
 {
     init_hardware();
 
+    // Tabuleiro pronto antes dos callbacks MQTT começarem a chegar
+    game_init();
+#if TRACE_RECORDING
+    trace_writer_init(&trace_writer);
+    trace_start_ms = to_ms_since_boot(get_absolute_time());
+#endif
+    lockstep_init(&life_grid, &life_rule, &life_generation);
+
     if (cyw43_arch_init())
     {
         printf("Erro ao inicializar WiFi chip\n");
@@ -458,20 +759,66 @@ int main()
     connect_to_wifi();
     init_mqtt();
 
+#if LIFE_DIST
+    dist_node_init(&dist_node, DIST_NODE_COL, DIST_NODE_ROW, DIST_NODE_COLS, DIST_NODE_ROWS,
+                   life_rule, (dist_transport_t){ .publish = dist_publish, .ctx = mqtt_client });
+#endif
+
     init_oled_display();
 
-    memset(life_grid, 0, sizeof(life_grid));
+#if TRACE_MODE == TRACE_REPLAY_FLASH
+    run_replay();
+#endif
 
     while (true)
     {
         cyw43_arch_poll(); // precisa para o WiFi/MQTT rodar
-        if (!life_running)
-            handle_joystick();
-        else
+
+        bool stepped = false;
+        handle_buttons();
+        handle_joystick(); // desenho: cursor; rodando: move a janela
+        if (life_running)
+        {
+#if LIFE_DIST
+            // Avança quando os halos dos vizinhos chegam (ou o timeout vence)
+            cyw43_arch_lwip_begin();
+            stepped = dist_node_poll(&dist_node, to_ms_since_boot(get_absolute_time()));
+            cyw43_arch_lwip_end();
+#else
+            // Padrão via MQTT entra entre dois passos, não entre o passo e a cópia
+            cyw43_arch_lwip_begin();
             update_life();
+            cyw43_arch_lwip_end();
+            stepped = true;
+#endif
+        }
+        record((trace_event_t){ .type = TRACE_FRAME, .stepped = stepped });
 
-        render_life();
-        sleep_ms(50);
+        if (life_dirty)
+        {
+            life_dirty = false;
+            lockstep_request_seed();
+        }
+#if !LIFE_DIST
+        cyw43_arch_lwip_begin();
+        lockstep_poll(mqtt_client);
+        cyw43_arch_lwip_end();
+#endif
+
+        render_frame();
+        flush_trace();
+        uint32_t now_ms = to_ms_since_boot(get_absolute_time());
+        report_ingest(now_ms);
+        report_display(now_ms);
+#if LIFE_AGE
+        // Os tons de cinza precisam de vários quadros por geração: até o
+        // próximo passo, quadros o mais rápido que o I2C deixar
+        absolute_time_t next_step = make_timeout_time_ms(LIFE_STEP_MS);
+        while (!time_reached(next_step))
+            render_frame();
+#else
+        sleep_ms(LIFE_STEP_MS);
+#endif
     }
 
     cyw43_arch_deinit();
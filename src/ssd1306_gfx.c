@@ -0,0 +1,151 @@
+#include "ssd1306_gfx.h"
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+#include "ssd1306_font.h"
+
+// ---------- Pixel helpers ----------
+void ssd1306_set_pixel(uint8_t *buf, int x, int y, bool on) {
+    if (x < 0 || x >= ssd1306_width || y < 0 || y >= ssd1306_height) return;
+    int page  = y / 8;
+    int bit   = y % 8;
+    int index = x + (page * ssd1306_width);
+    if (on) buf[index] |=  (1u << bit);
+    else    buf[index] &= ~(1u << bit);
+}
+
+void ssd1306_clear(uint8_t *buf) {
+    memset(buf, 0x00, ssd1306_buffer_length);
+}
+
+void ssd1306_draw_points(uint8_t *buf, int points[][2], int n_points) {
+    for (int i = 0; i < n_points; i++) {
+        ssd1306_set_pixel(buf, points[i][0], points[i][1], true);
+    }
+}
+
+// Optional: Bresenham line
+void ssd1306_draw_line(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
+    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
+    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
+    int err = dx + dy;
+    for (;;) {
+        ssd1306_set_pixel(buf, x0, y0, on);
+        if (x0 == x1 && y0 == y1) break;
+        int e2 = 2 * err;
+        if (e2 >= dy) { err += dy; x0 += sx; }
+        if (e2 <= dx) { err += dx; y0 += sy; }
+    }
+}
+
+// ---------- Blitter ----------
+// Trabalha por byte do framebuffer (8 pixels de uma coluna), não por pixel.
+
+// Máscara das linhas [y0, y1) dentro da página
+static inline uint8_t page_mask(int page, int y0, int y1) {
+    int top = y0 - page * 8;
+    int bottom = y1 - page * 8;
+    if (top < 0) top = 0;
+    if (bottom > 8) bottom = 8;
+    if (top >= bottom) return 0;
+    return (uint8_t)((0xFFu << top) & (0xFFu >> (8 - bottom)));
+}
+
+static inline void apply_op(uint8_t *dst, uint8_t bits, uint8_t mask, ssd1306_blit_op_t op) {
+    switch (op) {
+    case SSD1306_BLIT_COPY: *dst = (*dst & ~mask) | (bits & mask); break;
+    case SSD1306_BLIT_OR:   *dst |= bits & mask; break;
+    case SSD1306_BLIT_AND:  *dst &= bits | ~mask; break;
+    case SSD1306_BLIT_XOR:  *dst ^= bits & mask; break;
+    }
+}
+
+void ssd1306_blit(uint8_t *buf, int x, int y, const uint8_t *bitmap, int w, int h,
+                  ssd1306_blit_op_t op) {
+    // Recorte no display
+    int x0 = x < 0 ? 0 : x;
+    int x1 = x + w > ssd1306_width ? ssd1306_width : x + w;
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + h > ssd1306_height ? ssd1306_height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    int src_pages = (h + 7) / 8;
+    for (int page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        uint8_t mask = page_mask(page, y0, y1);
+        // Linha do bitmap que cai no bit 0 desta página
+        int row = page * 8 - y;
+        int sp = row >> 3;      // página do bitmap (pode ser -1)
+        int shift = row & 7;
+        uint8_t *dst = &buf[page * ssd1306_width + x0];
+        const uint8_t *lo = (sp >= 0 && sp < src_pages) ? &bitmap[sp * w + (x0 - x)] : NULL;
+        const uint8_t *hi = (sp + 1 >= 0 && sp + 1 < src_pages) ? &bitmap[(sp + 1) * w + (x0 - x)] : NULL;
+
+        for (int i = 0; i < x1 - x0; i++) {
+            unsigned bits = lo ? lo[i] >> shift : 0;
+            if (hi && shift) bits |= (unsigned)hi[i] << (8 - shift);
+            apply_op(&dst[i], (uint8_t)bits, mask, op);
+        }
+    }
+}
+
+void ssd1306_fill_rect(uint8_t *buf, int x, int y, int w, int h, bool on) {
+    int x0 = x < 0 ? 0 : x;
+    int x1 = x + w > ssd1306_width ? ssd1306_width : x + w;
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + h > ssd1306_height ? ssd1306_height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        uint8_t mask = page_mask(page, y0, y1);
+        uint8_t *dst = &buf[page * ssd1306_width + x0];
+        if (mask == 0xFF) {
+            memset(dst, on ? 0xFF : 0x00, x1 - x0);
+        } else if (on) {
+            for (int i = 0; i < x1 - x0; i++) dst[i] |= mask;
+        } else {
+            for (int i = 0; i < x1 - x0; i++) dst[i] &= ~mask;
+        }
+    }
+}
+
+void ssd1306_invert_rect(uint8_t *buf, int x, int y, int w, int h) {
+    int x0 = x < 0 ? 0 : x;
+    int x1 = x + w > ssd1306_width ? ssd1306_width : x + w;
+    int y0 = y < 0 ? 0 : y;
+    int y1 = y + h > ssd1306_height ? ssd1306_height : y + h;
+    if (x0 >= x1 || y0 >= y1) return;
+
+    for (int page = y0 / 8; page <= (y1 - 1) / 8; page++) {
+        uint8_t mask = page_mask(page, y0, y1);
+        uint8_t *dst = &buf[page * ssd1306_width + x0];
+        for (int i = 0; i < x1 - x0; i++) dst[i] ^= mask;
+    }
+}
+
+// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
+static inline int ssd1306_get_font(uint8_t character)
+{
+  if (character >= 'A' && character <= 'Z') {
+    return character - 'A' + 1;
+  }
+  else if (character >= '0' && character <= '9') {
+    return character - '0' + 27;
+  }
+  else
+    return 0;
+}
+
+// Desenha um único caractere no display, em qualquer (x, y), cortando nas bordas
+void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
+    character = toupper(character);
+    int idx = ssd1306_get_font(character);
+    ssd1306_blit(ssd, x, y, &font[idx * 8], 8, 8, SSD1306_BLIT_COPY);
+}
+
+// Desenha uma string, chamando a função de desenhar caractere várias vezes
+void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
+    while (*string && x < ssd1306_width) {
+        ssd1306_draw_char(ssd, x, y, *string++);
+        x += 8;
+    }
+}
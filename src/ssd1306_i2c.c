@@ -1,78 +1,52 @@
 #include "ssd1306.h"
 #include <string.h>
-#include <stdlib.h>
-#include <ctype.h>
-#include "ssd1306_font.h"
 
 uint8_t ssd1306_buffer[ssd1306_buffer_length];
 
+uint32_t ssd1306_i2c_bytes = 0;
+
+// Último quadro enviado por render_on_display_changes
+static uint8_t shown[ssd1306_buffer_length];
+static bool shown_valid = false;
+
 // ---------- Low-level I2C helpers ----------
+static void write_i2c(const uint8_t *pkt, int len) {
+    i2c_write_blocking(SSD1306_I2C_INST, ssd1306_i2c_address, pkt, len, false);
+    ssd1306_i2c_bytes += 1 + len; // + byte de endereço
+}
+
 void ssd1306_send_command(uint8_t cmd) {
     uint8_t pkt[2] = { 0x00, cmd }; // 0x00 = control byte for "command"
-    i2c_write_blocking(SSD1306_I2C_INST, ssd1306_i2c_address, pkt, 2, false);
+    write_i2c(pkt, 2);
 }
 
 void ssd1306_send_command_list(uint8_t *cmds, int number) {
-    for (int i = 0; i < number; i++) ssd1306_send_command(cmds[i]);
+    // Uma transação só: com Co = 0 todos os bytes seguintes são comandos
+    uint8_t pkt[1 + 32];
+    if (number > 32) {
+        for (int i = 0; i < number; i++) ssd1306_send_command(cmds[i]);
+        return;
+    }
+    pkt[0] = 0x00;
+    memcpy(&pkt[1], cmds, number);
+    write_i2c(pkt, 1 + number);
 }
 
 void ssd1306_send_buffer(uint8_t data[], int len) {
-    // Send in small chunks: [0x40, <up to N data bytes>]
-    const int CHUNK = 16;
-    uint8_t pkt[1 + CHUNK];
+    // [0x40, <dados>] numa transação só; o I2C do RP2040 não tem limite de
+    // tamanho e cada transação extra custa endereço + controle
+    static uint8_t pkt[1 + ssd1306_buffer_length];
     pkt[0] = 0x40; // 0x40 = control byte for "data"
 
     int sent = 0;
     while (sent < len) {
-        int n = (len - sent > CHUNK) ? CHUNK : (len - sent);
+        int n = (len - sent > ssd1306_buffer_length) ? ssd1306_buffer_length : (len - sent);
         memcpy(&pkt[1], &data[sent], n);
-        i2c_write_blocking(SSD1306_I2C_INST, ssd1306_i2c_address, pkt, 1 + n, false);
+        write_i2c(pkt, 1 + n);
         sent += n;
     }
 }
 
-// Adquire os pixels para um caractere (de acordo com ssd1306_font.h)
-inline int ssd1306_get_font(uint8_t character)
-{
-  if (character >= 'A' && character <= 'Z') {
-    return character - 'A' + 1;
-  }
-  else if (character >= '0' && character <= '9') {
-    return character - '0' + 27;
-  }
-  else
-    return 0;
-}
-
-// Desenha um único caractere no display
-void ssd1306_draw_char(uint8_t *ssd, int16_t x, int16_t y, uint8_t character) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    y = y / 8;
-
-    character = toupper(character);
-    int idx = ssd1306_get_font(character);
-    int fb_idx = y * 128 + x;
-
-    for (int i = 0; i < 8; i++) {
-        ssd[fb_idx++] = font[idx * 8 + i];
-    }
-}
-
-// Desenha uma string, chamando a função de desenhar caractere várias vezes
-void ssd1306_draw_string(uint8_t *ssd, int16_t x, int16_t y, char *string) {
-    if (x > ssd1306_width - 8 || y > ssd1306_height - 8) {
-        return;
-    }
-
-    while (*string) {
-        ssd1306_draw_char(ssd, x, y, *string++);
-        x += 8;
-    }
-}
-
 // Comando de configuração com base na estrutura ssd1306_t
 void ssd1306_command(ssd1306_t *ssd, uint8_t command) {
   ssd->port_buffer[1] = command;
@@ -121,23 +95,52 @@ void ssd1306_init(void) {
     };
     ssd1306_send_command_list(init_cmds, (int)sizeof(init_cmds));
     sleep_ms(10);
+    shown_valid = false; // RAM do display com lixo
 }
 
 void render_on_display(uint8_t *buf, struct render_area *area) {
-    // Column address
-    ssd1306_send_command(0x21); // SET COLUMN ADDRESS
-    ssd1306_send_command(area->start_column);
-    ssd1306_send_command(area->end_column);
-
-    // Page address
-    ssd1306_send_command(0x22); // SET PAGE ADDRESS
-    ssd1306_send_command(area->start_page);
-    ssd1306_send_command(area->end_page);
+    uint8_t cmds[] = {
+        0x21, area->start_column, area->end_column, // SET COLUMN ADDRESS
+        0x22, area->start_page, area->end_page,     // SET PAGE ADDRESS
+    };
+    ssd1306_send_command_list(cmds, (int)sizeof(cmds));
 
     // Data
     ssd1306_send_buffer(buf, area->buffer_length);
 }
 
+void render_on_display_changes(uint8_t *buf, struct render_area *area) {
+    if (area->buffer_length != ssd1306_buffer_length) {
+        render_on_display(buf, area);
+        shown_valid = false;
+        return;
+    }
+    if (!shown_valid) {
+        render_on_display(buf, area);
+        memcpy(shown, buf, ssd1306_buffer_length);
+        shown_valid = true;
+        return;
+    }
+
+    // Por página, só as colunas entre a primeira e a última que mudaram
+    for (int page = 0; page < ssd1306_n_pages; page++) {
+        uint8_t *now = buf + page * ssd1306_width;
+        uint8_t *old = shown + page * ssd1306_width;
+        int first = 0, last = ssd1306_width - 1;
+        while (first <= last && now[first] == old[first]) first++;
+        if (first > last) continue;
+        while (now[last] == old[last]) last--;
+
+        struct render_area part = {
+            .start_column = first, .end_column = last,
+            .start_page = page, .end_page = page,
+        };
+        calculate_render_area_buffer_length(&part);
+        render_on_display(now + first, &part);
+        memcpy(old + first, now + first, last - first + 1);
+    }
+}
+
 // ---------- Optional: start/stop a simple horizontal scroll ----------
 void ssd1306_scroll(bool enable) {
     if (!enable) {
@@ -156,37 +159,3 @@ void ssd1306_scroll(bool enable) {
     };
     ssd1306_send_command_list(cmds, (int)sizeof(cmds));
 }
-
-// ---------- Pixel helpers ----------
-void ssd1306_set_pixel(uint8_t *buf, int x, int y, bool on) {
-    if (x < 0 || x >= ssd1306_width || y < 0 || y >= ssd1306_height) return;
-    int page  = y / 8;
-    int bit   = y % 8;
-    int index = x + (page * ssd1306_width);
-    if (on) buf[index] |=  (1u << bit);
-    else    buf[index] &= ~(1u << bit);
-}
-
-void ssd1306_clear(uint8_t *buf) {
-    memset(buf, 0x00, ssd1306_buffer_length);
-}
-
-void ssd1306_draw_points(uint8_t *buf, int points[][2], int n_points) {
-    for (int i = 0; i < n_points; i++) {
-        ssd1306_set_pixel(buf, points[i][0], points[i][1], true);
-    }
-}
-
-// Optional: Bresenham line
-void ssd1306_draw_line(uint8_t *buf, int x0, int y0, int x1, int y1, bool on) {
-    int dx = abs(x1 - x0), sx = x0 < x1 ? 1 : -1;
-    int dy = -abs(y1 - y0), sy = y0 < y1 ? 1 : -1;
-    int err = dx + dy;
-    for (;;) {
-        ssd1306_set_pixel(buf, x0, y0, on);
-        if (x0 == x1 && y0 == y1) break;
-        int e2 = 2 * err;
-        if (e2 >= dy) { err += dy; x0 += sx; }
-        if (e2 <= dx) { err += dx; y0 += sy; }
-    }
-}
@@ -0,0 +1,196 @@
+#include "trace.h"
+#include <string.h>
+
+// ---------- Helpers ----------
+
+static int put_varint(uint8_t *out, uint32_t v)
+{
+    int n = 0;
+    while (v >= 0x80)
+    {
+        out[n++] = (v & 0x7F) | 0x80;
+        v >>= 7;
+    }
+    out[n++] = v;
+    return n;
+}
+
+static bool get_varint(trace_reader_t *r, uint32_t *v)
+{
+    uint32_t result = 0;
+    for (int shift = 0; shift < 35; shift += 7)
+    {
+        if (r->pos >= r->len)
+            return false;
+        uint8_t b = r->data[r->pos++];
+        result |= (uint32_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+        {
+            *v = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ---------- Writer ----------
+
+void trace_writer_init(trace_writer_t *w)
+{
+    memcpy(w->buf, TRACE_MAGIC, 4);
+    w->buf[4] = TRACE_VERSION;
+    w->len = TRACE_HEADER_LEN;
+    w->last_ms = 0;
+    w->dropped = 0;
+    w->unreported = 0;
+}
+
+// Quem chama já conferiu o espaço
+static void append(trace_writer_t *w, const trace_event_t *ev)
+{
+
+    // Eventos fora de ordem (IRQ no meio de um evento do loop) viram delta 0
+    uint32_t delta = ev->time_ms >= w->last_ms ? ev->time_ms - w->last_ms : 0;
+    w->last_ms += delta;
+
+    uint8_t *out = w->buf + w->len;
+    int n = 0;
+    out[n++] = ev->type;
+    n += put_varint(out + n, delta);
+
+    switch (ev->type)
+    {
+    case TRACE_FRAME:
+        out[n++] = ev->stepped;
+        break;
+    case TRACE_MOVE:
+        out[n++] = (uint8_t)ev->dx;
+        out[n++] = (uint8_t)ev->dy;
+        break;
+    case TRACE_MQTT:
+        out[n++] = ev->last ? 1 : 0;
+        n += put_varint(out + n, ev->len);
+        memcpy(out + n, ev->data, ev->len);
+        n += ev->len;
+        break;
+    case TRACE_MQTT_BEGIN:
+        n += put_varint(out + n, ev->total_length);
+        break;
+    case TRACE_DROPPED:
+        n += put_varint(out + n, ev->count);
+        break;
+    default:
+        break;
+    }
+    w->len += n;
+}
+
+void trace_write(trace_writer_t *w, const trace_event_t *ev)
+{
+    // O buraco fica marcado antes do primeiro evento que entra depois dele,
+    // então os dois só entram juntos
+    int need = TRACE_EVENT_MAX + (ev->type == TRACE_MQTT ? ev->len : 0);
+    if (w->unreported)
+        need += TRACE_EVENT_MAX;
+    if (w->len + need > TRACE_BUFFER_SIZE)
+    {
+        w->dropped++;
+        w->unreported++;
+        return;
+    }
+
+    if (w->unreported)
+    {
+        trace_event_t gap = { .type = TRACE_DROPPED, .time_ms = ev->time_ms, .count = w->unreported };
+        append(w, &gap);
+        w->unreported = 0;
+    }
+    append(w, ev);
+}
+
+int trace_take(trace_writer_t *w, uint8_t *out, int max)
+{
+    int n = w->len < max ? w->len : max;
+    memcpy(out, w->buf, n);
+    memmove(w->buf, w->buf + n, w->len - n);
+    w->len -= n;
+    return n;
+}
+
+int trace_truncated(uint8_t *out)
+{
+    // Delta 0: a marca não tem hora própria
+    out[0] = TRACE_TRUNCATED;
+    out[1] = 0;
+    return TRACE_TRUNCATED_LEN;
+}
+
+// ---------- Reader ----------
+
+bool trace_reader_init(trace_reader_t *r, const uint8_t *data, size_t len)
+{
+    r->data = data;
+    r->len = len;
+    r->pos = TRACE_HEADER_LEN;
+    r->time_ms = 0;
+    return len >= TRACE_HEADER_LEN && memcmp(data, TRACE_MAGIC, 4) == 0 &&
+           data[4] == TRACE_VERSION;
+}
+
+bool trace_next(trace_reader_t *r, trace_event_t *ev)
+{
+    if (r->pos >= r->len || r->data[r->pos] == TRACE_END)
+        return false;
+
+    memset(ev, 0, sizeof(*ev));
+    ev->type = r->data[r->pos++];
+
+    uint32_t delta;
+    if (!get_varint(r, &delta))
+        return false;
+    r->time_ms += delta;
+    ev->time_ms = r->time_ms;
+
+    switch (ev->type)
+    {
+    case TRACE_FRAME:
+        if (r->pos + 1 > r->len)
+            return false;
+        ev->stepped = r->data[r->pos++];
+        break;
+    case TRACE_MOVE:
+        if (r->pos + 2 > r->len)
+            return false;
+        ev->dx = (int8_t)r->data[r->pos++];
+        ev->dy = (int8_t)r->data[r->pos++];
+        break;
+    case TRACE_MQTT:
+    {
+        uint32_t len;
+        if (r->pos + 1 > r->len)
+            return false;
+        ev->last = r->data[r->pos++] & 1;
+        if (!get_varint(r, &len) || len > UINT16_MAX || r->pos + len > r->len)
+            return false;
+        ev->data = r->data + r->pos;
+        ev->len = len;
+        r->pos += len;
+        break;
+    }
+    case TRACE_MQTT_BEGIN:
+        if (!get_varint(r, &ev->total_length))
+            return false;
+        break;
+    case TRACE_DROPPED:
+        if (!get_varint(r, &ev->count))
+            return false;
+        break;
+    case TRACE_BTN_A:
+    case TRACE_BTN_B:
+    case TRACE_TRUNCATED:
+        break;
+    default:
+        return false; // tipo desconhecido: trace corrompido
+    }
+    return true;
+}
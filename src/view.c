@@ -0,0 +1,357 @@
+#include "view.h"
+#include <string.h>
+
+#define VIEW_WORDS (ssd1306_width / 32) // palavras por linha de pixels
+
+// ---------- Bits ----------
+
+// 32 células a partir da coluna x; zero fora de [0, limit)
+static inline uint32_t fetch32(const uint32_t *row, int stride, int x, int limit)
+{
+    if (!row || x >= limit)
+        return 0;
+    int w = x >> 5;
+    int s = x & 31;
+    uint32_t lo = (w >= 0 && w < stride) ? row[w] : 0;
+    uint32_t hi = (s && w + 1 >= 0 && w + 1 < stride) ? row[w + 1] : 0;
+    uint32_t bits = s ? (lo >> s) | (hi << (32 - s)) : lo;
+    if (x < 0)
+        bits &= x <= -32 ? 0 : 0xFFFFFFFFu << -x;
+    if (limit - x < 32)
+        bits &= (1u << (limit - x)) - 1u;
+    return bits;
+}
+
+// Duplica cada bit dos 16 bits de baixo: bit i -> bits 2i e 2i + 1
+static inline uint32_t spread2(uint32_t v)
+{
+    v &= 0xFFFF;
+    v = (v | (v << 8)) & 0x00FF00FF;
+    v = (v | (v << 4)) & 0x0F0F0F0F;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v | (v << 1);
+}
+
+// Junta os bits pares (0, 2, 4...) nos 16 bits de baixo
+static inline uint32_t compact2(uint32_t v)
+{
+    v &= 0x55555555;
+    v = (v | (v >> 1)) & 0x33333333;
+    v = (v | (v >> 2)) & 0x0F0F0F0F;
+    v = (v | (v >> 4)) & 0x00FF00FF;
+    v = (v | (v >> 8)) & 0x0000FFFF;
+    return v;
+}
+
+// Junta os bits 0, 4, 8... nos 8 bits de baixo
+static inline uint32_t compact4(uint32_t v)
+{
+    v &= 0x11111111;
+    v = (v | (v >> 3)) & 0x03030303;
+    v = (v | (v >> 6)) & 0x000F000F;
+    v = (v | (v >> 12)) & 0x000000FF;
+    return v;
+}
+
+// Blocos 2x2 de duas linhas -> 16 pixels
+static inline uint32_t reduce2(uint32_t r0, uint32_t r1, view_reduce_t reduce)
+{
+    if (reduce == VIEW_REDUCE_OR)
+        return compact2((r0 | r1) | ((r0 | r1) >> 1));
+
+    // Soma das 4 células em bits separados (uns, dois, quatro), comparada
+    // com VIEW_DENSITY_2X2; o switch some na compilação
+    uint32_t a = r0, b = r0 >> 1, c = r1, d = r1 >> 1;
+    uint32_t s0 = a ^ b, c0 = a & b;
+    uint32_t s1 = c ^ d, c1 = c & d;
+    uint32_t carry = s0 & s1;
+    uint32_t ones = s0 ^ s1;
+    uint32_t twos = c0 ^ c1 ^ carry;
+    uint32_t fours = c0 & c1; // com 4 vivas não sobra carry
+    uint32_t hit;
+    switch (VIEW_DENSITY_2X2)
+    {
+    case 0: hit = ~0u; break;
+    case 1: hit = ones | twos | fours; break;
+    case 2: hit = twos | fours; break;
+    case 3: hit = fours | (twos & ones); break;
+    case 4: hit = fours; break;
+    default: hit = 0; break;
+    }
+    return compact2(hit);
+}
+
+// Blocos 4x4 de quatro linhas -> 8 pixels
+static inline uint32_t reduce4(const uint32_t r[4], view_reduce_t reduce)
+{
+    if (reduce == VIEW_REDUCE_OR)
+    {
+        uint32_t v = r[0] | r[1] | r[2] | r[3];
+        return compact4(v | (v >> 1) | (v >> 2) | (v >> 3));
+    }
+
+    // Contagem por nibble (SWAR), somada em bytes para caber 16
+    uint32_t even = 0, odd = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        uint32_t c = r[i] - ((r[i] >> 1) & 0x55555555);
+        c = (c & 0x33333333) + ((c >> 2) & 0x33333333);
+        even += c & 0x0F0F0F0F;
+        odd += (c >> 4) & 0x0F0F0F0F;
+    }
+    const uint32_t bias = 0x01010101u * (0x80 - VIEW_DENSITY_4X4);
+    uint32_t hit_even = ((even + bias) >> 7) & 0x01010101;
+    uint32_t hit_odd = ((odd + bias) >> 7) & 0x01010101;
+    return compact4(hit_even | (hit_odd << 4));
+}
+
+// Transpõe um bloco 8x8: byte k = linha k (bit j = coluna j) vira
+// byte j = coluna j (bit k = linha k), o formato de páginas do SSD1306
+static inline uint64_t transpose8(uint64_t x)
+{
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAull;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCull;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ull;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+// Linhas de pixels empacotadas -> framebuffer em páginas
+static void rows_to_pages(const uint32_t rows[ssd1306_height][VIEW_WORDS], uint8_t *buf)
+{
+    for (int page = 0; page < ssd1306_n_pages; page++)
+    {
+        const uint32_t (*band)[VIEW_WORDS] = &rows[page * 8];
+        for (int col = 0; col < ssd1306_width; col += 8)
+        {
+            int w = col / 32, s = col % 32;
+            uint64_t block = 0;
+            for (int k = 0; k < 8; k++)
+                block |= (uint64_t)((band[k][w] >> s) & 0xFF) << (8 * k);
+            if (!block)
+            {
+                memset(&buf[page * ssd1306_width + col], 0, 8);
+                continue;
+            }
+            block = transpose8(block);
+            for (int j = 0; j < 8; j++)
+                buf[page * ssd1306_width + col + j] = (block >> (8 * j)) & 0xFF;
+        }
+    }
+}
+
+// ---------- Janela ----------
+
+int view_cells_w(const view_t *view)
+{
+    return view->zoom >= 0 ? ssd1306_width >> view->zoom : ssd1306_width << -view->zoom;
+}
+
+int view_cells_h(const view_t *view)
+{
+    return view->zoom >= 0 ? ssd1306_height >> view->zoom : ssd1306_height << -view->zoom;
+}
+
+void view_clamp(view_t *view, int cols, int rows)
+{
+    int max_x = cols - view_cells_w(view);
+    int max_y = rows - view_cells_h(view);
+    if (view->x > max_x) view->x = max_x;
+    if (view->y > max_y) view->y = max_y;
+    if (view->x < 0) view->x = 0;
+    if (view->y < 0) view->y = 0;
+}
+
+void view_pan(view_t *view, int dx, int dy, int cols, int rows)
+{
+    view->x += dx;
+    view->y += dy;
+    view_clamp(view, cols, rows);
+}
+
+void view_follow(view_t *view, int cx, int cy, int cols, int rows)
+{
+    int w = view_cells_w(view), h = view_cells_h(view);
+    if (cx < view->x) view->x = cx;
+    if (cx >= view->x + w) view->x = cx - w + 1;
+    if (cy < view->y) view->y = cy;
+    if (cy >= view->y + h) view->y = cy - h + 1;
+    view_clamp(view, cols, rows);
+}
+
+bool view_cell_rect(const view_t *view, int cx, int cy, int *px, int *py, int *size)
+{
+    int dx = cx - view->x, dy = cy - view->y;
+    if (dx < 0 || dy < 0 || dx >= view_cells_w(view) || dy >= view_cells_h(view))
+        return false;
+    if (view->zoom >= 0)
+    {
+        *px = dx << view->zoom;
+        *py = dy << view->zoom;
+        *size = 1 << view->zoom;
+    }
+    else
+    {
+        *px = dx >> -view->zoom;
+        *py = dy >> -view->zoom;
+        *size = 1;
+    }
+    return true;
+}
+
+// ---------- Render ----------
+
+void view_render(const view_t *view, const life_grid_t *grid, int ox, int oy, uint8_t *buf)
+{
+    static uint32_t rows[ssd1306_height][VIEW_WORDS];
+    const int cols = grid->width - 2 * ox;
+    const int nrows = grid->height - 2 * oy;
+    const int limit = ox + cols;
+    const int x0 = ox + view->x;
+
+    // Linha r do conteúdo, NULL fora dele
+#define SRC_ROW(r) (((r) >= 0 && (r) < nrows) ? life_row(grid, oy + (r)) : NULL)
+
+    for (int py = 0; py < ssd1306_height; py++)
+    {
+        uint32_t *out = rows[py];
+
+        if (view->zoom >= 0)
+        {
+            // 1:1 ou ampliado: cada palavra de saída vem de 32 >> zoom células
+            const uint32_t *src = SRC_ROW(view->y + (py >> view->zoom));
+            const int cells = 32 >> view->zoom;
+            for (int k = 0; k < VIEW_WORDS; k++)
+            {
+                uint32_t bits = fetch32(src, grid->stride, x0 + k * cells, limit);
+                for (int z = 0; z < view->zoom; z++)
+                    bits = spread2(bits);
+                out[k] = bits;
+            }
+        }
+        else if (view->zoom == -1)
+        {
+            int r = view->y + 2 * py;
+            const uint32_t *s0 = SRC_ROW(r), *s1 = SRC_ROW(r + 1);
+            for (int k = 0; k < VIEW_WORDS; k++)
+            {
+                int x = x0 + k * 64;
+                uint32_t lo = reduce2(fetch32(s0, grid->stride, x, limit),
+                                      fetch32(s1, grid->stride, x, limit), view->reduce);
+                uint32_t hi = reduce2(fetch32(s0, grid->stride, x + 32, limit),
+                                      fetch32(s1, grid->stride, x + 32, limit), view->reduce);
+                out[k] = lo | (hi << 16);
+            }
+        }
+        else
+        {
+            int r = view->y + 4 * py;
+            const uint32_t *src[4] = { SRC_ROW(r), SRC_ROW(r + 1), SRC_ROW(r + 2), SRC_ROW(r + 3) };
+            for (int k = 0; k < VIEW_WORDS; k++)
+            {
+                uint32_t word = 0;
+                for (int q = 0; q < 4; q++)
+                {
+                    int x = x0 + k * 128 + q * 32;
+                    uint32_t r4[4];
+                    for (int i = 0; i < 4; i++)
+                        r4[i] = fetch32(src[i], grid->stride, x, limit);
+                    word |= reduce4(r4, view->reduce) << (8 * q);
+                }
+                out[k] = word;
+            }
+        }
+    }
+#undef SRC_ROW
+
+    rows_to_pages(rows, buf);
+}
+
+// ---------- Idade em tons de cinza ----------
+
+// Células com idade <= limit, comparando os planos do bit mais alto para o
+// mais baixo
+static inline uint32_t age_at_most(const uint32_t *planes[LIFE_AGE_BITS], int w, int limit)
+{
+    uint32_t less = 0, equal = ~0u;
+    for (int k = LIFE_AGE_BITS - 1; k >= 0; k--)
+    {
+        uint32_t p = planes[k][w];
+        if ((limit >> k) & 1)
+        {
+            less |= equal & ~p;
+            equal &= p;
+        }
+        else
+            equal &= ~p;
+    }
+    return less | equal;
+}
+
+// Acende as células de live (e, com dying, as que estão morrendo) nos
+// quadros em que o nível vence o limiar; nível >= t é valor <= oldest[t]
+static void dither(const life_grid_t *live, const life_age_t *age, bool dying,
+                   const int oldest[VIEW_GREY_FRAMES + 1], unsigned frame, life_grid_t *out)
+{
+    for (int y = 0; y < live->height; y++)
+    {
+        // Limiar da coluna x: (frame + x + 2y) % VIEW_GREY_FRAMES + 1, o mesmo
+        // padrão em toda palavra porque 32 é múltiplo de VIEW_GREY_FRAMES
+        uint32_t columns[VIEW_GREY_FRAMES + 1];
+        for (int t = 1; t <= VIEW_GREY_FRAMES; t++)
+        {
+            int first = ((t - 1 - (int)(frame % VIEW_GREY_FRAMES) - 2 * y) % VIEW_GREY_FRAMES +
+                         VIEW_GREY_FRAMES) % VIEW_GREY_FRAMES;
+            uint32_t mask = 0;
+            for (int x = first; x < LIFE_WORD_BITS; x += VIEW_GREY_FRAMES)
+                mask |= 1u << x;
+            columns[t] = mask;
+        }
+
+        const uint32_t *planes[LIFE_AGE_BITS];
+        for (int k = 0; k < LIFE_AGE_BITS; k++)
+            planes[k] = life_row(&age->planes[k], y);
+        const uint32_t *row = life_row(live, y);
+        uint32_t *dst = life_row(out, y);
+
+        for (int w = 0; w < live->stride; w++)
+        {
+            uint32_t shown = row[w];
+            if (dying)
+                for (int k = 0; k < LIFE_AGE_BITS; k++)
+                    shown |= planes[k][w];
+
+            uint32_t lit = 0;
+            for (int t = 1; t <= VIEW_GREY_FRAMES; t++)
+                lit |= columns[t] & age_at_most(planes, w, oldest[t]);
+            dst[w] = shown & lit;
+        }
+    }
+}
+
+void view_dither_age(const life_grid_t *live, const life_age_t *age, unsigned frame,
+                     life_grid_t *out)
+{
+    // Nível caindo linearmente da idade 0 (VIEW_GREY_FRAMES) até
+    // LIFE_AGE_MAX (1)
+    int oldest[VIEW_GREY_FRAMES + 1];
+    for (int t = 1; t <= VIEW_GREY_FRAMES; t++)
+        oldest[t] = (VIEW_GREY_FRAMES - t + 1) * (LIFE_AGE_MAX + 1) / VIEW_GREY_FRAMES - 1;
+    dither(live, age, false, oldest, frame, out);
+}
+
+void view_dither_gen(const life_grid_t *live, const life_age_t *dying, int states, unsigned frame,
+                     life_grid_t *out)
+{
+    // Vivas (valor 0) em VIEW_GREY_FRAMES; as que estão morrendo caem de
+    // VIEW_GREY_FRAMES - 1 até 1 no último valor, states - 2
+    int last = states > 2 ? states - 2 : 1;
+    int oldest[VIEW_GREY_FRAMES + 1];
+    for (int t = 1; t <= VIEW_GREY_FRAMES; t++)
+        oldest[t] = (VIEW_GREY_FRAMES - t) * last / (VIEW_GREY_FRAMES - 1);
+    dither(live, dying, true, oldest, frame, out);
+}
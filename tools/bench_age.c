@@ -0,0 +1,374 @@
+// Benchmark do modo idade: planos de idade no passo (life_step_age e, nas
+// regras Generations, life_step_gen) e composição do dithering temporal
+// (view_dither_age e view_dither_gen).
+// Antes de medir, confere tudo contra referências por célula em
+// tabuleiros aleatórios (sai com 1 se algo divergir). Depois mede no
+// tabuleiro do jogo e estima os bytes de I2C por quadro de uma sopa rodando
+// com o dithering, no formato do driver (quadro inteiro e só o que mudou).
+//
+//   bench_age [casos]
+
+#include "game.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_W 200
+#define MAX_H 100
+#define I2C_BITS_PER_BYTE 9 // 8 bits + ACK
+
+static uint32_t cur_cells[LIFE_GRID_WORDS(MAX_W, MAX_H)];
+static uint32_t next_cells[LIFE_GRID_WORDS(MAX_W, MAX_H)];
+static uint32_t plain_cells[LIFE_GRID_WORDS(MAX_W, MAX_H)];
+static uint32_t age_cells[LIFE_AGE_BITS * LIFE_GRID_WORDS(MAX_W, MAX_H)];
+static uint32_t out_cells[LIFE_GRID_WORDS(MAX_W, MAX_H)];
+static uint32_t dying_cells[LIFE_AGE_BITS * LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+static uint8_t ref_age[MAX_H][MAX_W];
+static uint8_t ref_state[MAX_H][MAX_W], ref_next[MAX_H][MAX_W];
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void random_grid(life_grid_t *grid, int percent)
+{
+    for (int y = 0; y < grid->height; y++)
+        for (int x = 0; x < grid->width; x++)
+            life_set(grid, x, y, rand() % 100 < percent);
+}
+
+// ---------- Referências ----------
+
+static int ref_level(int age)
+{
+    return VIEW_GREY_FRAMES - age * VIEW_GREY_FRAMES / (LIFE_AGE_MAX + 1);
+}
+
+static bool ref_lit(const life_grid_t *live, int x, int y, int age, unsigned frame)
+{
+    int threshold = (int)((frame + x + 2 * y) % VIEW_GREY_FRAMES) + 1;
+    return life_get(live, x, y) && ref_level(age) >= threshold;
+}
+
+// Generations: 0 morta, 1 viva, 2 .. states - 1 morrendo
+static void ref_step_gen(int w, int h, life_rule_t rule)
+{
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+        {
+            int n = 0;
+            for (int dy = -1; dy <= 1; dy++)
+                for (int dx = -1; dx <= 1; dx++)
+                {
+                    int nx = x + dx, ny = y + dy;
+                    if ((dx || dy) && nx >= 0 && nx < w && ny >= 0 && ny < h)
+                        n += ref_state[ny][nx] == 1;
+                }
+            int s = ref_state[y][x];
+            if (s == 0)
+                s = (rule.birth >> n) & 1u;
+            else if (s == 1)
+                s = (rule.survive >> n) & 1u ? 1 : rule.states > 2 ? 2 : 0;
+            else
+                s = s + 1 < rule.states ? s + 1 : 0;
+            ref_next[y][x] = s;
+        }
+    memcpy(ref_state, ref_next, sizeof(ref_state));
+}
+
+// Viva em todos os quadros; morrendo de VIEW_GREY_FRAMES - 1 até 1
+static bool ref_lit_gen(int x, int y, int states, unsigned frame)
+{
+    int s = ref_state[y][x], level;
+    if (s == 0)
+        return false;
+    if (s == 1)
+        level = VIEW_GREY_FRAMES;
+    else
+    {
+        int v = s - 1, last = states - 2;
+        level = VIEW_GREY_FRAMES - (v * (VIEW_GREY_FRAMES - 1) + last - 1) / last;
+    }
+    return level >= (int)((frame + x + 2 * y) % VIEW_GREY_FRAMES) + 1;
+}
+
+// ---------- Conferência ----------
+
+static long verify(int cases)
+{
+    long failures = 0;
+    for (int c = 0; c < cases && failures < 10; c++)
+    {
+        int w = 1 + rand() % MAX_W, h = 1 + rand() % MAX_H;
+        life_grid_t cur, next, plain, out;
+        life_age_t age;
+        life_grid_init(&cur, cur_cells, w, h);
+        life_grid_init(&next, next_cells, w, h);
+        life_grid_init(&plain, plain_cells, w, h);
+        life_grid_init(&out, out_cells, w, h);
+        life_age_init(&age, age_cells, w, h);
+        random_grid(&cur, 10 + rand() % 40);
+        memset(ref_age, 0, sizeof(ref_age));
+        life_rule_t rule = rand() % 4 ? LIFE_RULE_CONWAY
+                                      : (life_rule_t){ .birth = rand() & 0x1FE, .survive = rand() & 0x1FF };
+
+        for (int gen = 0; gen < 20 && failures < 10; gen++)
+        {
+            life_step(&cur, &plain, rule);
+            life_step_age(&cur, &next, rule, &age);
+            if (memcmp(plain.cells, next.cells, LIFE_GRID_WORDS(w, h) * sizeof(uint32_t)) != 0)
+            {
+                printf("DIVERGIU: %dx%d geração %d, células de life_step_age != life_step\n", w, h, gen);
+                failures++;
+            }
+
+            for (int y = 0; y < h; y++)
+                for (int x = 0; x < w; x++)
+                {
+                    bool was = life_get(&cur, x, y), is = life_get(&next, x, y);
+                    ref_age[y][x] = was && is ? (ref_age[y][x] < LIFE_AGE_MAX ? ref_age[y][x] + 1 : LIFE_AGE_MAX) : 0;
+                    if (life_age_get(&age, x, y) != ref_age[y][x] && failures++ < 10)
+                        printf("DIVERGIU: %dx%d geração %d, idade de (%d,%d) %d != %d\n", w, h, gen, x, y,
+                               life_age_get(&age, x, y), ref_age[y][x]);
+                }
+
+            unsigned frame = rand();
+            view_dither_age(&next, &age, frame, &out);
+            for (int y = 0; y < h; y++)
+                for (int x = 0; x < w; x++)
+                    if (life_get(&out, x, y) != ref_lit(&next, x, y, ref_age[y][x], frame) && failures++ < 10)
+                        printf("DIVERGIU: %dx%d quadro %u, (%d,%d) idade %d\n", w, h, frame, x, y,
+                               ref_age[y][x]);
+
+            life_copy(&cur, &next);
+        }
+    }
+    return failures;
+}
+
+static long verify_gen(int cases)
+{
+    // Regras Generations no texto, nas duas notações
+    static const struct { const char *text, *formatted; } rules[] = {
+        { "B2/S/C3", "B2/S/C3" }, { "/2/3", "B2/S/C3" }, { "345/2/4", "B2/S345/C4" },
+        { "B3/S23/C2", "B3/S23" }, { "B2/S/C10", NULL }, { "B2/S/C", NULL },
+    };
+    long failures = 0;
+    for (size_t i = 0; i < sizeof(rules) / sizeof(rules[0]); i++)
+    {
+        life_rule_t rule;
+        char text[LIFE_RULE_TEXT_MAX] = "";
+        bool ok = life_parse_rule(rules[i].text, &rule);
+        if (ok)
+            life_format_rule(rule, text, sizeof(text));
+        if (ok != (rules[i].formatted != NULL) || (ok && strcmp(text, rules[i].formatted) != 0))
+        {
+            printf("DIVERGIU: regra \"%s\" lida como \"%s\"\n", rules[i].text, ok ? text : "(erro)");
+            failures++;
+        }
+    }
+
+    for (int c = 0; c < cases && failures < 10; c++)
+    {
+        int w = 1 + rand() % MAX_W, h = 1 + rand() % MAX_H;
+        life_grid_t cur, next, out;
+        life_age_t dying;
+        life_grid_init(&cur, cur_cells, w, h);
+        life_grid_init(&next, next_cells, w, h);
+        life_grid_init(&out, out_cells, w, h);
+        life_age_init(&dying, age_cells, w, h);
+        random_grid(&cur, 10 + rand() % 40);
+        life_rule_t rule = { .birth = rand() & 0x1FE, .survive = rand() & 0x1FF,
+                             .states = 2 + rand() % (LIFE_GEN_STATES_MAX - 1) };
+        if (rand() % 4 == 0)
+            rule = rand() % 2 ? LIFE_RULE_BRIANS_BRAIN : LIFE_RULE_STAR_WARS;
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++)
+                ref_state[y][x] = life_get(&cur, x, y);
+
+        for (int gen = 0; gen < 20 && failures < 10; gen++)
+        {
+            life_step_gen(&cur, &next, rule, &dying);
+            ref_step_gen(w, h, rule);
+            for (int y = 0; y < h; y++)
+                for (int x = 0; x < w; x++)
+                {
+                    int s = ref_state[y][x];
+                    int live = life_get(&next, x, y), value = life_age_get(&dying, x, y);
+                    if ((live != (s == 1) || value != (s > 1 ? s - 1 : 0)) && failures++ < 10)
+                        printf("DIVERGIU: %dx%d C%d geração %d, (%d,%d) viva %d valor %d, estado %d\n", w,
+                               h, rule.states, gen, x, y, live, value, s);
+                }
+
+            if (rule.states > 2)
+            {
+                unsigned frame = rand();
+                view_dither_gen(&next, &dying, rule.states, frame, &out);
+                for (int y = 0; y < h; y++)
+                    for (int x = 0; x < w; x++)
+                        if (life_get(&out, x, y) != ref_lit_gen(x, y, rule.states, frame) &&
+                            failures++ < 10)
+                            printf("DIVERGIU: %dx%d C%d quadro %u, (%d,%d) estado %d\n", w, h,
+                                   rule.states, frame, x, y, ref_state[y][x]);
+            }
+
+            life_copy(&cur, &next);
+        }
+    }
+    return failures;
+}
+
+// ---------- I2C ----------
+
+// Bytes no barramento como o driver manda (endereço + controle + dados)
+static long i2c_full_old(void)
+{
+    // 6 comandos de 2 bytes e dados em pedaços de 16, uma transação cada
+    return 6 * (1 + 2) + (ssd1306_buffer_length / 16) * (1 + 1 + 16);
+}
+
+static long i2c_full(void)
+{
+    return (1 + 1 + 6) + (1 + 1 + ssd1306_buffer_length);
+}
+
+// render_on_display_changes: por página, da primeira à última coluna mudada
+static long i2c_changes(const uint8_t *now, uint8_t *shown)
+{
+    long bytes = 0;
+    for (int page = 0; page < ssd1306_n_pages; page++)
+    {
+        const uint8_t *a = now + page * ssd1306_width;
+        uint8_t *b = shown + page * ssd1306_width;
+        int first = 0, last = ssd1306_width - 1;
+        while (first <= last && a[first] == b[first])
+            first++;
+        if (first > last)
+            continue;
+        while (a[last] == b[last])
+            last--;
+        bytes += (1 + 1 + 6) + (1 + 1 + last - first + 1);
+        memcpy(b + first, a + first, last - first + 1);
+    }
+    return bytes;
+}
+
+static void print_i2c(const char *name, double bytes)
+{
+    printf("%-26s %7.0f bytes   %5.1f quadros/s a 400 kHz   %5.1f a 1 MHz\n", name, bytes,
+           400e3 / (bytes * I2C_BITS_PER_BYTE), 1e6 / (bytes * I2C_BITS_PER_BYTE));
+}
+
+int main(int argc, char **argv)
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 200;
+    srand(1);
+
+    long failures = verify(cases) + verify_gen(cases);
+    printf("conferência: %d casos, %ld divergências\n", 2 * cases, failures);
+    if (failures)
+        return 1;
+
+    // Sopa no tabuleiro do jogo, já com idades variadas
+    life_grid_t cur, next, out;
+    life_age_t age;
+    life_grid_init(&cur, cur_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&next, next_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&out, out_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_age_init(&age, age_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    random_grid(&cur, 35);
+    for (int gen = 0; gen < 50; gen++)
+    {
+        life_step_age(&cur, &next, LIFE_RULE_CONWAY, &age);
+        life_copy(&cur, &next);
+    }
+
+    // life_step e life_step_age alternados em rodadas, ficando com a melhor
+    // de cada: uma rodada só varia de 10% a 20% de uma execução para outra,
+    // mais que a diferença que se quer medir.
+    // Sempre o mesmo cur, então a idade satura; o custo não depende disso
+    const int iterations = 20000, rounds = 10;
+    double plain = 1e30, aged = 1e30, gen = 1e30;
+    life_age_t dying;
+    life_age_init(&dying, dying_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    for (int r = 0; r < rounds; r++)
+    {
+        double start = now_ns();
+        for (int i = 0; i < iterations / rounds; i++)
+            life_step(&cur, &next, LIFE_RULE_CONWAY);
+        double ns = (now_ns() - start) / (iterations / rounds);
+        if (ns < plain)
+            plain = ns;
+
+        start = now_ns();
+        for (int i = 0; i < iterations / rounds; i++)
+            life_step_age(&cur, &next, LIFE_RULE_CONWAY, &age);
+        ns = (now_ns() - start) / (iterations / rounds);
+        if (ns < aged)
+            aged = ns;
+
+        start = now_ns();
+        for (int i = 0; i < iterations / rounds; i++)
+            life_step_gen(&cur, &next, LIFE_RULE_BRIANS_BRAIN, &dying);
+        ns = (now_ns() - start) / (iterations / rounds);
+        if (ns < gen)
+            gen = ns;
+    }
+
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++)
+        view_dither_age(&cur, &age, i, &out);
+    double dither = (now_ns() - start) / iterations;
+
+    start = now_ns();
+    for (int i = 0; i < iterations; i++)
+        view_dither_gen(&cur, &dying, LIFE_RULE_BRIANS_BRAIN.states, i, &out);
+    double dither_gen = (now_ns() - start) / iterations;
+
+    static uint8_t buf[ssd1306_buffer_length];
+    view_t view = { .reduce = VIEW_REDUCE_OR };
+    start = now_ns();
+    for (int i = 0; i < iterations; i++)
+    {
+        view_dither_age(&cur, &age, i, &out);
+        view_render(&view, &out, 0, 0, buf);
+    }
+    double frame = (now_ns() - start) / iterations;
+
+    printf("%dx%d, %d bits de idade, %d quadros por ciclo de cinza\n", LIFE_GRID_WIDTH,
+           LIFE_GRID_HEIGHT, LIFE_AGE_BITS, VIEW_GREY_FRAMES);
+    printf("%-26s %9.1f ns\n", "life_step", plain);
+    printf("%-26s %9.1f ns   (+%.0f%%)\n", "life_step_age", aged, 100.0 * (aged - plain) / plain);
+    printf("%-26s %9.1f ns   (+%.0f%%)\n", "life_step_gen (B2/S/C3)", gen, 100.0 * (gen - plain) / plain);
+    printf("%-26s %9.1f ns\n", "view_dither_age", dither);
+    printf("%-26s %9.1f ns\n", "view_dither_gen", dither_gen);
+    printf("%-26s %9.1f ns\n", "dither + view_render", frame);
+
+    // Bytes de I2C por quadro com a sopa rodando: um passo a cada
+    // frames_per_step quadros, como no laço do firmware
+    static uint8_t shown[ssd1306_buffer_length];
+    const int frames = 2000, frames_per_step = 8;
+    long changed = 0;
+    for (int f = 0; f < frames; f++)
+    {
+        if (f % frames_per_step == 0)
+        {
+            life_step_age(&cur, &next, LIFE_RULE_CONWAY, &age);
+            life_copy(&cur, &next);
+        }
+        view_dither_age(&cur, &age, f, &out);
+        view_render(&view, &out, 0, 0, buf);
+        long bytes = i2c_changes(buf, shown);
+        if (f)
+            changed += bytes; // o primeiro quadro vai inteiro
+    }
+    printf("I2C por quadro (população %d):\n", life_population(&cur));
+    print_i2c("antes, quadro inteiro", i2c_full_old());
+    print_i2c("quadro inteiro", i2c_full());
+    print_i2c("só o que mudou", (double)changed / (frames - 1));
+    return 0;
+}
@@ -0,0 +1,248 @@
+// Benchmark do blitter de src/ssd1306_gfx.c contra o desenho pixel a pixel.
+// Antes de medir, confere o resultado pixel a pixel contra uma implementação
+// de referência em posições, tamanhos e operações aleatórias, inclusive texto
+// (draw_char/draw_string contra a tabela da fonte) fora do alinhamento de
+// página e cortado nas bordas (sai com 1 se algum framebuffer divergir).
+//
+//   bench_gfx [casos]
+
+#include "ssd1306_gfx.h"
+#include "ssd1306_font.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define MAX_SPRITE 48
+#define MAX_TEXT   20 // caracteres por string nos casos de texto
+
+static bool get_pixel(const uint8_t *buf, int x, int y)
+{
+    return (buf[(y / 8) * ssd1306_width + x] >> (y % 8)) & 1u;
+}
+
+// ---------- Referência pixel a pixel ----------
+
+static void ref_blit(uint8_t *buf, int x, int y, const uint8_t *bitmap, int w, int h,
+                     ssd1306_blit_op_t op)
+{
+    for (int by = 0; by < h; by++)
+        for (int bx = 0; bx < w; bx++)
+        {
+            int dx = x + bx, dy = y + by;
+            if (dx < 0 || dx >= ssd1306_width || dy < 0 || dy >= ssd1306_height)
+                continue;
+            bool src = (bitmap[(by / 8) * w + bx] >> (by % 8)) & 1u;
+            bool dst = get_pixel(buf, dx, dy);
+            bool out = op == SSD1306_BLIT_COPY ? src
+                     : op == SSD1306_BLIT_OR   ? (dst || src)
+                     : op == SSD1306_BLIT_AND  ? (dst && src)
+                                               : (dst != src);
+            ssd1306_set_pixel(buf, dx, dy, out);
+        }
+}
+
+static void ref_fill(uint8_t *buf, int x, int y, int w, int h, int mode)
+{
+    for (int dy = y; dy < y + h; dy++)
+        for (int dx = x; dx < x + w; dx++)
+            if (dx >= 0 && dx < ssd1306_width && dy >= 0 && dy < ssd1306_height)
+                ssd1306_set_pixel(buf, dx, dy, mode == 2 ? !get_pixel(buf, dx, dy) : mode);
+}
+
+// Caractere direto da tabela da fonte: coluna i = byte i, linha = bit
+static void ref_char(uint8_t *buf, int x, int y, char c)
+{
+    c = toupper((unsigned char)c);
+    int glyph = c >= 'A' && c <= 'Z' ? c - 'A' + 1 : c >= '0' && c <= '9' ? c - '0' + 27 : 0;
+    for (int col = 0; col < 8; col++)
+        for (int row = 0; row < 8; row++)
+        {
+            int dx = x + col, dy = y + row;
+            if (dx >= 0 && dx < ssd1306_width && dy >= 0 && dy < ssd1306_height)
+                ssd1306_set_pixel(buf, dx, dy, (font[glyph * 8 + col] >> row) & 1u);
+        }
+}
+
+static void ref_string(uint8_t *buf, int x, int y, const char *s)
+{
+    for (; *s; s++, x += 8)
+        ref_char(buf, x, y, *s);
+}
+
+static void random_bytes(uint8_t *p, int n)
+{
+    for (int i = 0; i < n; i++)
+        p[i] = rand() & 0xFF;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ---------- Conferência ----------
+
+static long verify(int cases)
+{
+    static uint8_t a[ssd1306_buffer_length], b[ssd1306_buffer_length];
+    uint8_t sprite[MAX_SPRITE * ((MAX_SPRITE + 7) / 8)];
+    long failures = 0;
+
+    for (int c = 0; c < cases; c++)
+    {
+        random_bytes(a, sizeof(a));
+        memcpy(b, a, sizeof(a));
+        int x = rand() % (ssd1306_width + 2 * MAX_SPRITE) - MAX_SPRITE;
+        int y = rand() % (ssd1306_height + 2 * MAX_SPRITE) - MAX_SPRITE;
+        int w = 1 + rand() % MAX_SPRITE;
+        int h = 1 + rand() % MAX_SPRITE;
+        int kind = rand() % 8;
+        const char *name;
+        // Letras (as duas caixas), dígitos e o que não está na fonte
+        static const char charset[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789 .:-/";
+        char text[MAX_TEXT + 1];
+
+        if (kind < 4)
+        {
+            random_bytes(sprite, w * ((h + 7) / 8));
+            ssd1306_blit(a, x, y, sprite, w, h, (ssd1306_blit_op_t)kind);
+            ref_blit(b, x, y, sprite, w, h, (ssd1306_blit_op_t)kind);
+            name = "blit";
+        }
+        else if (kind == 4)
+        {
+            bool on = rand() & 1;
+            ssd1306_fill_rect(a, x, y, w, h, on);
+            ref_fill(b, x, y, w, h, on);
+            name = "fill_rect";
+        }
+        else if (kind == 5)
+        {
+            ssd1306_invert_rect(a, x, y, w, h);
+            ref_fill(b, x, y, w, h, 2);
+            name = "invert_rect";
+        }
+        else
+        {
+            // Texto em qualquer x, y, inclusive cortado em todas as bordas
+            int n = kind == 6 ? 1 : 1 + rand() % MAX_TEXT;
+            for (int i = 0; i < n; i++)
+                text[i] = charset[rand() % (sizeof(charset) - 1)];
+            text[n] = 0;
+            x = rand() % (ssd1306_width + 8 * n + 8) - 8 * n;
+            y = rand() % (ssd1306_height + 16) - 8;
+            if (kind == 6)
+            {
+                ssd1306_draw_char(a, x, y, text[0]);
+                name = "draw_char";
+            }
+            else
+            {
+                ssd1306_draw_string(a, x, y, text);
+                name = "draw_string";
+            }
+            ref_string(b, x, y, text);
+            w = 8 * n;
+            h = 8;
+        }
+
+        if (memcmp(a, b, sizeof(a)) != 0)
+        {
+            if (failures++ < 10)
+                printf("DIVERGIU: %s op=%d x=%d y=%d w=%d h=%d%s%s\n", name, kind, x, y, w, h,
+                       kind >= 6 ? " texto=" : "", kind >= 6 ? text : "");
+        }
+    }
+    return failures;
+}
+
+// ---------- Medição ----------
+
+typedef void (*bench_fn)(uint8_t *buf, int i);
+
+static const uint8_t *bench_sprite;
+
+static void blit_sprite(uint8_t *buf, int i)
+{
+    ssd1306_blit(buf, (i * 7) % 112, (i * 3) % 48, bench_sprite, 16, 16, SSD1306_BLIT_XOR);
+}
+
+static void pixel_sprite(uint8_t *buf, int i)
+{
+    ref_blit(buf, (i * 7) % 112, (i * 3) % 48, bench_sprite, 16, 16, SSD1306_BLIT_XOR);
+}
+
+static void fill_screen(uint8_t *buf, int i)
+{
+    ssd1306_fill_rect(buf, 1, 1, 126, 62, i & 1);
+}
+
+static void pixel_fill_screen(uint8_t *buf, int i)
+{
+    ref_fill(buf, 1, 1, 126, 62, i & 1);
+}
+
+static void text_unaligned(uint8_t *buf, int i)
+{
+    ssd1306_draw_string(buf, 3, 1 + i % 50, "GERACAO 1234");
+}
+
+static void pixel_text_unaligned(uint8_t *buf, int i)
+{
+    // Mesmo texto pelo caminho antigo: um set_pixel por pixel da fonte
+    static uint8_t glyphs[12 * 8 * 8];
+    static bool ready = false;
+    if (!ready)
+    {
+        uint8_t tmp[ssd1306_buffer_length] = {0};
+        ssd1306_draw_string(tmp, 0, 0, "GERACAO 1234");
+        memcpy(glyphs, tmp, 12 * 8);
+        ready = true;
+    }
+    ref_blit(buf, 3, 1 + i % 50, glyphs, 12 * 8, 8, SSD1306_BLIT_COPY);
+}
+
+static double measure(bench_fn fn, int iterations)
+{
+    static uint8_t buf[ssd1306_buffer_length];
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++)
+        fn(buf, i);
+    double elapsed = now_ns() - start;
+    volatile uint8_t sink = buf[iterations % ssd1306_buffer_length];
+    (void)sink;
+    return elapsed / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 20000;
+    srand(1);
+
+    long failures = verify(cases);
+    printf("conferência: %d casos, %ld divergências\n", cases, failures);
+    if (failures)
+        return 1;
+
+    static uint8_t sprite[16 * 2];
+    random_bytes(sprite, sizeof(sprite));
+    bench_sprite = sprite;
+
+    const struct { const char *name; bench_fn fast, slow; int iterations; } benches[] = {
+        { "sprite 16x16 XOR desalinhado", blit_sprite, pixel_sprite, 200000 },
+        { "retângulo 126x62", fill_screen, pixel_fill_screen, 20000 },
+        { "texto 12 chars desalinhado", text_unaligned, pixel_text_unaligned, 100000 },
+    };
+    for (size_t i = 0; i < sizeof(benches) / sizeof(benches[0]); i++)
+    {
+        double fast = measure(benches[i].fast, benches[i].iterations);
+        double slow = measure(benches[i].slow, benches[i].iterations);
+        printf("%-30s blitter %9.1f ns   pixel a pixel %9.1f ns   %5.1fx\n",
+               benches[i].name, fast, slow, slow / fast);
+    }
+    return 0;
+}
@@ -0,0 +1,183 @@
+// Benchmark do viewport de src/view.c (zoom e deslocamento) contra o render
+// antigo de render_life, um life_get + set_pixel por pixel.
+// Antes de medir, confere cada zoom e modo de redução contra uma referência
+// por célula em tabuleiros, densidades e janelas aleatórias (sai com 1 se
+// algum framebuffer divergir). Os tempos saem também como fração do quadro
+// de 50 ms do laço principal.
+//
+//   bench_render [casos]
+
+#include "view.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define FRAME_BUDGET_NS 50e6 // sleep_ms(50) do laço principal
+
+#define MAX_W (4 * ssd1306_width)
+#define MAX_H (4 * ssd1306_height)
+
+static uint32_t cells[LIFE_GRID_WORDS(MAX_W, MAX_H)];
+
+// ---------- Referência por célula ----------
+
+static bool ref_pixel(const view_t *view, const life_grid_t *grid, int ox, int oy, int px, int py)
+{
+    int cols = grid->width - 2 * ox, rows = grid->height - 2 * oy;
+    if (view->zoom >= 0)
+    {
+        int cx = view->x + (px >> view->zoom), cy = view->y + (py >> view->zoom);
+        return cx < cols && cy < rows && life_get(grid, ox + cx, oy + cy);
+    }
+
+    int f = 1 << -view->zoom, alive = 0;
+    for (int dy = 0; dy < f; dy++)
+        for (int dx = 0; dx < f; dx++)
+        {
+            int cx = view->x + px * f + dx, cy = view->y + py * f + dy;
+            if (cx < cols && cy < rows && life_get(grid, ox + cx, oy + cy))
+                alive++;
+        }
+    if (view->reduce == VIEW_REDUCE_OR)
+        return alive > 0;
+    return alive >= (f == 2 ? VIEW_DENSITY_2X2 : VIEW_DENSITY_4X4);
+}
+
+static void ref_render(const view_t *view, const life_grid_t *grid, int ox, int oy, uint8_t *buf)
+{
+    ssd1306_clear(buf);
+    for (int py = 0; py < ssd1306_height; py++)
+        for (int px = 0; px < ssd1306_width; px++)
+            if (ref_pixel(view, grid, ox, oy, px, py))
+                ssd1306_set_pixel(buf, px, py, true);
+}
+
+// Render de antes do viewport: 1:1 a partir de (ox, oy)
+static void old_render(const life_grid_t *grid, int ox, int oy, uint8_t *buf)
+{
+    ssd1306_clear(buf);
+    for (int x = 0; x < ssd1306_width; x++)
+        for (int y = 0; y < ssd1306_height; y++)
+            if (life_get(grid, ox + x, oy + y))
+                ssd1306_set_pixel(buf, x, y, true);
+}
+
+static void random_grid(life_grid_t *grid, int w, int h, int percent)
+{
+    life_grid_init(grid, cells, w, h);
+    for (int y = 0; y < h; y++)
+        for (int x = 0; x < w; x++)
+            if (rand() % 100 < percent)
+                life_set(grid, x, y, true);
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// ---------- Conferência ----------
+
+static long verify(int cases)
+{
+    static uint8_t a[ssd1306_buffer_length], b[ssd1306_buffer_length];
+    long failures = 0;
+
+    for (int c = 0; c < cases; c++)
+    {
+        life_grid_t grid;
+        int w = 1 + rand() % MAX_W, h = 1 + rand() % MAX_H;
+        random_grid(&grid, w, h, rand() % 101);
+
+        int ox = 0, oy = 0;
+        if (c % 4 == 0 && w > 2 && h > 2)
+            ox = oy = 1; // tile com halo
+        int cols = w - 2 * ox, rows = h - 2 * oy;
+
+        view_t view = {
+            .x = rand() % (cols + 1),
+            .y = rand() % (rows + 1),
+            .zoom = VIEW_ZOOM_MIN + rand() % (VIEW_ZOOM_MAX - VIEW_ZOOM_MIN + 1),
+            .reduce = rand() & 1 ? VIEW_REDUCE_DENSITY : VIEW_REDUCE_OR,
+        };
+        if (rand() & 1)
+            view_clamp(&view, cols, rows);
+
+        memset(a, 0xA5, sizeof(a)); // view_render precisa escrever o buffer todo
+        view_render(&view, &grid, ox, oy, a);
+        ref_render(&view, &grid, ox, oy, b);
+
+        if (memcmp(a, b, sizeof(a)) != 0)
+        {
+            if (failures++ < 10)
+                printf("DIVERGIU: %dx%d halo=%d janela=(%d,%d) zoom=%d redução=%d\n",
+                       w, h, ox, view.x, view.y, view.zoom, view.reduce);
+        }
+    }
+    return failures;
+}
+
+// ---------- Medição ----------
+
+static double measure_view(const view_t *view, const life_grid_t *grid, int iterations)
+{
+    static uint8_t buf[ssd1306_buffer_length];
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++)
+        view_render(view, grid, 0, 0, buf);
+    double elapsed = now_ns() - start;
+    volatile uint8_t sink = buf[iterations % ssd1306_buffer_length];
+    (void)sink;
+    return elapsed / iterations;
+}
+
+static double measure_old(const life_grid_t *grid, int iterations)
+{
+    static uint8_t buf[ssd1306_buffer_length];
+    double start = now_ns();
+    for (int i = 0; i < iterations; i++)
+        old_render(grid, 0, 0, buf);
+    double elapsed = now_ns() - start;
+    volatile uint8_t sink = buf[iterations % ssd1306_buffer_length];
+    (void)sink;
+    return elapsed / iterations;
+}
+
+int main(int argc, char **argv)
+{
+    int cases = argc > 1 ? atoi(argv[1]) : 5000;
+    srand(1);
+
+    long failures = verify(cases);
+    printf("conferência: %d casos, %ld divergências\n", cases, failures);
+    if (failures)
+        return 1;
+
+    // Tabuleiro do tamanho de 4x4 telas para o zoom 1/4 ter o que resumir
+    life_grid_t grid;
+    random_grid(&grid, MAX_W, MAX_H, 30);
+
+    double old = measure_old(&grid, 2000);
+    printf("%-24s %9.1f ns   %6.3f%% do quadro\n", "antigo 1:1 por pixel", old,
+           100.0 * old / FRAME_BUDGET_NS);
+
+    for (int zoom = VIEW_ZOOM_MIN; zoom <= VIEW_ZOOM_MAX; zoom++)
+        for (int reduce = 0; reduce < (zoom < 0 ? 2 : 1); reduce++)
+        {
+            view_t view = { .x = 3, .y = 5, .zoom = zoom, .reduce = (view_reduce_t)reduce };
+            view_clamp(&view, grid.width, grid.height);
+            double ns = measure_view(&view, &grid, 20000);
+            char name[32];
+            if (zoom >= 0)
+                snprintf(name, sizeof(name), "zoom %dx", 1 << zoom);
+            else
+                snprintf(name, sizeof(name), "zoom 1/%d %s", 1 << -zoom,
+                         reduce == VIEW_REDUCE_OR ? "OR" : "densidade");
+            printf("%-24s %9.1f ns   %6.3f%% do quadro   %5.1fx\n", name, ns,
+                   100.0 * ns / FRAME_BUDGET_NS, old / ns);
+        }
+    return 0;
+}
@@ -0,0 +1,295 @@
+// Simulador de host do modo distribuído: N nós (um por thread) rodando o mesmo
+// src/dist.c do firmware, trocando halos por um broker loopback em memória.
+//
+//   dist_sim [-c colunas] [-r linhas] [-g gerações] [-s semente]
+//            [-t timeout_ms] [-k col-linha@geração] [-R reinício_ms]
+//
+// Sem -k o resultado é conferido contra um único tabuleiro do tamanho do
+// universo inteiro. -k derruba um nó na geração dada (para de publicar);
+// -R o recoloca depois de um tempo, vazio, para exercitar o rejoin.
+
+#include "dist.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_NODES 64
+#define MAILBOX_LEN 64
+
+// ---------- Broker loopback ----------
+
+typedef struct {
+    uint8_t data[DIST_HALO_MAX];
+    int len;
+} message_t;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    message_t queue[MAILBOX_LEN];
+    int head, count;
+    unsigned long refused; // publicações recusadas por esta fila estar cheia
+} mailbox_t;
+
+typedef struct {
+    int id;
+    int col, row;
+    dist_node_t node;
+    mailbox_t mailbox;
+    uint32_t kill_at; // 0 = nunca
+    unsigned long steps;
+    volatile bool running; // nó parado não drena a fila, então não recebe
+    pthread_t thread;
+} sim_node_t;
+
+static sim_node_t *nodes;
+static int node_count;
+static int mesh_cols = 2, mesh_rows = 2;
+static uint32_t target_gens = 200;
+static uint32_t timeout_ms = 500;
+static int restart_ms = -1;
+static const life_grid_t *initial;
+
+static uint32_t now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)(ts.tv_sec * 1000u + ts.tv_nsec / 1000000u);
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Todos os nós assinam DIST_HALO_TOPIC "/+", como no firmware. Com a fila
+// de algum nó cheia o broker recusa a mensagem inteira (como mqtt_publish
+// com o buffer de envio cheio) e quem publicou tenta de novo.
+static bool broker_publish(void *ctx, const char *topic, const uint8_t *payload, int len)
+{
+    (void)ctx;
+    (void)topic;
+    // Trava todas as filas em ordem: ou entra em todas, ou em nenhuma
+    for (int i = 0; i < node_count; i++)
+        pthread_mutex_lock(&nodes[i].mailbox.lock);
+    bool room = true;
+    for (int i = 0; i < node_count; i++)
+        if (nodes[i].running && nodes[i].mailbox.count == MAILBOX_LEN)
+            room = false;
+    for (int i = 0; i < node_count; i++)
+    {
+        mailbox_t *mb = &nodes[i].mailbox;
+        if (!room)
+        {
+            if (nodes[i].running && mb->count == MAILBOX_LEN)
+                mb->refused++;
+        }
+        else if (nodes[i].running)
+        {
+            message_t *m = &mb->queue[(mb->head + mb->count) % MAILBOX_LEN];
+            memcpy(m->data, payload, len);
+            m->len = len;
+            mb->count++;
+            pthread_cond_signal(&mb->cond);
+        }
+        pthread_mutex_unlock(&mb->lock);
+    }
+    return room;
+}
+
+// ---------- Nós ----------
+
+static void drain_mailbox(sim_node_t *sn, bool wait)
+{
+    mailbox_t *mb = &sn->mailbox;
+    pthread_mutex_lock(&mb->lock);
+    if (wait && mb->count == 0)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        ts.tv_nsec += 1000000;
+        if (ts.tv_nsec >= 1000000000)
+        {
+            ts.tv_sec++;
+            ts.tv_nsec -= 1000000000;
+        }
+        pthread_cond_timedwait(&mb->cond, &mb->lock, &ts);
+    }
+    while (mb->count > 0)
+    {
+        message_t m = mb->queue[mb->head];
+        mb->head = (mb->head + 1) % MAILBOX_LEN;
+        mb->count--;
+        pthread_mutex_unlock(&mb->lock);
+        dist_node_on_message(&sn->node, m.data, m.len);
+        pthread_mutex_lock(&mb->lock);
+    }
+    pthread_mutex_unlock(&mb->lock);
+}
+
+static void node_start(sim_node_t *sn, const life_grid_t *pattern)
+{
+    dist_node_init(&sn->node, sn->col, sn->row, mesh_cols, mesh_rows, LIFE_RULE_CONWAY,
+                   (dist_transport_t){ .publish = broker_publish, .ctx = NULL });
+    sn->node.timeout_ms = timeout_ms;
+    if (pattern)
+        dist_node_load(&sn->node, pattern, sn->col * DIST_TILE_WIDTH, sn->row * DIST_TILE_HEIGHT);
+}
+
+static void *node_thread(void *arg)
+{
+    sim_node_t *sn = arg;
+    bool restarted = false;
+
+    while (sn->node.generation < target_gens)
+    {
+        if (sn->kill_at && !restarted && sn->node.generation == sn->kill_at)
+        {
+            printf("sim: derrubando nó %d-%d na geração %lu\n", sn->col, sn->row,
+                   (unsigned long)sn->kill_at);
+            sn->running = false;
+            if (restart_ms < 0)
+                return NULL;
+            usleep(restart_ms * 1000);
+            pthread_mutex_lock(&sn->mailbox.lock);
+            sn->mailbox.count = 0;
+            pthread_mutex_unlock(&sn->mailbox.lock);
+            node_start(sn, NULL); // reboot: tile vazio, geração 0
+            sn->running = true;
+            restarted = true;
+            printf("sim: nó %d-%d reiniciado\n", sn->col, sn->row);
+        }
+
+        drain_mailbox(sn, false);
+        if (dist_node_poll(&sn->node, now_ms()))
+            sn->steps++;
+        else
+            drain_mailbox(sn, true);
+    }
+    sn->running = false;
+    return NULL;
+}
+
+// ---------- Main ----------
+
+int main(int argc, char **argv)
+{
+    unsigned seed = 1;
+    int kill_col = -1, kill_row = -1;
+    unsigned kill_gen = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "c:r:g:s:t:k:R:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c': mesh_cols = atoi(optarg); break;
+        case 'r': mesh_rows = atoi(optarg); break;
+        case 'g': target_gens = strtoul(optarg, NULL, 10); break;
+        case 's': seed = strtoul(optarg, NULL, 10); break;
+        case 't': timeout_ms = strtoul(optarg, NULL, 10); break;
+        case 'k':
+            if (sscanf(optarg, "%d-%d@%u", &kill_col, &kill_row, &kill_gen) != 3)
+            {
+                fprintf(stderr, "formato de -k: col-linha@geração\n");
+                return 2;
+            }
+            break;
+        case 'R': restart_ms = atoi(optarg); break;
+        default:
+            fprintf(stderr, "uso: %s [-c cols] [-r rows] [-g gens] [-s seed] [-t timeout_ms] "
+                            "[-k col-row@gen] [-R restart_ms]\n", argv[0]);
+            return 2;
+        }
+    }
+    int cols = mesh_cols, rows = mesh_rows;
+    node_count = cols * rows;
+    if (node_count < 1 || node_count > MAX_NODES)
+    {
+        fprintf(stderr, "malha de 1 a %d nós\n", MAX_NODES);
+        return 2;
+    }
+
+    // Universo inteiro, usado para semear os nós e conferir o resultado
+    int width = cols * DIST_TILE_WIDTH, height = rows * DIST_TILE_HEIGHT;
+    uint32_t *cells = calloc(LIFE_GRID_WORDS(width, height), sizeof(uint32_t));
+    uint32_t *next_cells = calloc(LIFE_GRID_WORDS(width, height), sizeof(uint32_t));
+    life_grid_t universe, next;
+    life_grid_init(&universe, cells, width, height);
+    life_grid_init(&next, next_cells, width, height);
+    srand(seed);
+    for (int y = 0; y < height; y++)
+        for (int x = 0; x < width; x++)
+            life_set(&universe, x, y, rand() % 3 == 0);
+    initial = &universe;
+
+    nodes = calloc(node_count, sizeof(sim_node_t));
+    for (int i = 0; i < node_count; i++)
+    {
+        sim_node_t *sn = &nodes[i];
+        sn->id = i;
+        sn->col = i % cols;
+        sn->row = i / cols;
+        pthread_mutex_init(&sn->mailbox.lock, NULL);
+        pthread_cond_init(&sn->mailbox.cond, NULL);
+        if (sn->col == kill_col && sn->row == kill_row)
+            sn->kill_at = kill_gen;
+    }
+    for (int i = 0; i < node_count; i++)
+    {
+        node_start(&nodes[i], initial);
+        nodes[i].running = true;
+    }
+
+    double start = now_s();
+    for (int i = 0; i < node_count; i++)
+        pthread_create(&nodes[i].thread, NULL, node_thread, &nodes[i]);
+    for (int i = 0; i < node_count; i++)
+        pthread_join(nodes[i].thread, NULL);
+    double elapsed = now_s() - start;
+
+    // ---- Relatório ----
+    unsigned long total_steps = 0, total_bytes = 0, total_halos = 0, refused = 0;
+    for (int i = 0; i < node_count; i++)
+    {
+        sim_node_t *sn = &nodes[i];
+        printf("nó %d-%d: geração %lu, passos %lu, timeouts %lu, rejoins %lu, publicações recusadas %lu, "
+               "halos perdidos %lu, halo médio %.1f bytes\n",
+               sn->col, sn->row, (unsigned long)sn->node.generation, sn->steps,
+               (unsigned long)sn->node.timeouts, (unsigned long)sn->node.rejoins,
+               (unsigned long)sn->node.publish_failures, (unsigned long)sn->node.halos_missed,
+               sn->node.halos_sent ? (double)sn->node.halo_bytes_sent / sn->node.halos_sent : 0.0);
+        total_steps += sn->steps;
+        total_bytes += sn->node.halo_bytes_sent;
+        total_halos += sn->node.halos_sent;
+        refused += sn->mailbox.refused;
+    }
+    double cells_per_s = (double)total_steps * DIST_TILE_WIDTH * DIST_TILE_HEIGHT / elapsed;
+    printf("%d nós, %lu gerações, %.3f s: %.0f células/s, %.1f bytes/halo, %lu recusas por fila cheia\n",
+           node_count, (unsigned long)target_gens, elapsed, cells_per_s,
+           total_halos ? (double)total_bytes / total_halos : 0.0, refused);
+
+    if (kill_col >= 0)
+        return 0;
+
+    // ---- Confere contra o universo num tabuleiro só ----
+    for (uint32_t g = 0; g < target_gens; g++)
+    {
+        life_step(&universe, &next, LIFE_RULE_CONWAY);
+        life_copy(&universe, &next);
+    }
+    long mismatches = 0;
+    for (int i = 0; i < node_count; i++)
+        for (int y = 0; y < DIST_TILE_HEIGHT; y++)
+            for (int x = 0; x < DIST_TILE_WIDTH; x++)
+                if (dist_node_get(&nodes[i].node, x, y) !=
+                    life_get(&universe, nodes[i].col * DIST_TILE_WIDTH + x, nodes[i].row * DIST_TILE_HEIGHT + y))
+                    mismatches++;
+    printf("verificação: %s (%ld células diferentes)\n", mismatches ? "FALHOU" : "OK", mismatches);
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+// Confere que o kernel do firmware (src/life.c) e o do frontend
+// (frontend/life.js) dão o mesmo tabuleiro, bit a bit: os dois rodam as
+// mesmas sopas em vários tamanhos e regras B/S e os checksums (life_checksum
+// e lifeChecksum) depois de cada número de gerações têm que bater.
+// Roda o lado JavaScript com node (tools/kernel_check.js); é o teste do
+// ctest.
+//
+//   kernel_check [node] [kernel_check.js]
+
+#include "life.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    int width, height;
+    const char *rule;
+    int gens;
+} config_t;
+
+// Larguras dentro, no limite e além de uma palavra; regras com nascimento
+// em 0, 1 e 8 vizinhos para exercitar todas as contagens
+static const config_t configs[] = {
+    { 1, 1, "B3/S23", 5 },
+    { 31, 7, "B3/S23", 40 },
+    { 32, 32, "B36/S23", 60 },
+    { 33, 17, "B1357/S1357", 30 },
+    { 64, 3, "B2/S", 25 },
+    { 100, 1, "B1/S012345678", 10 },
+    { 128, 64, "B3678/S34678", 80 },
+    { 136, 72, "B3/S23", 200 },
+    { 97, 45, "B0/S8", 7 },
+    { 65, 65, "B35678/S5678", 50 },
+};
+#define CONFIG_COUNT ((int)(sizeof(configs) / sizeof(configs[0])))
+
+// xorshift32, igual ao de kernel_check.js
+static void random_board(life_grid_t *grid, uint32_t seed)
+{
+    uint32_t s = seed ? seed : 1;
+    for (int y = 0; y < grid->height; y++)
+        for (int x = 0; x < grid->width; x++)
+        {
+            s ^= s << 13;
+            s ^= s >> 17;
+            s ^= s << 5;
+            if (s % 100 < 35)
+                life_set(grid, x, y, true);
+        }
+}
+
+int main(int argc, char **argv)
+{
+    const char *node = argc > 1 ? argv[1] : "node";
+    const char *script = argc > 2 ? argv[2] : "kernel_check.js";
+
+    static uint32_t a[LIFE_GRID_WORDS(256, 256)], b[LIFE_GRID_WORDS(256, 256)];
+    uint32_t expected[CONFIG_COUNT];
+    life_rule_t rules[CONFIG_COUNT];
+
+    char command[4096];
+    int len = snprintf(command, sizeof(command), "\"%s\" \"%s\"", node, script);
+    for (int i = 0; i < CONFIG_COUNT; i++)
+    {
+        const config_t *c = &configs[i];
+        if (!life_parse_rule(c->rule, &rules[i]))
+        {
+            printf("regra inválida: %s\n", c->rule);
+            return 1;
+        }
+        life_grid_t cur, next;
+        life_grid_init(&cur, a, c->width, c->height);
+        life_grid_init(&next, b, c->width, c->height);
+        random_board(&cur, 1000 + i);
+        for (int g = 0; g < c->gens; g++)
+        {
+            life_step(&cur, &next, rules[i]);
+            life_grid_t t = cur;
+            cur = next;
+            next = t;
+        }
+        expected[i] = life_checksum(&cur);
+        len += snprintf(command + len, sizeof(command) - len, " %d %d %u %u %d %d", c->width,
+                        c->height, rules[i].birth, rules[i].survive, 1000 + i, c->gens);
+    }
+
+    FILE *js = popen(command, "r");
+    if (!js)
+    {
+        printf("não deu para rodar %s\n", node);
+        return 1;
+    }
+    int failures = 0, got_count = 0;
+    char line[64];
+    while (got_count < CONFIG_COUNT && fgets(line, sizeof(line), js))
+    {
+        const config_t *c = &configs[got_count];
+        uint32_t got = (uint32_t)strtoul(line, NULL, 16);
+        bool ok = got == expected[got_count];
+        printf("%-4s %3dx%-3d %-16s %4d gerações  C %08lx  JS %08lx\n", ok ? "ok" : "DIVERGIU",
+               c->width, c->height, c->rule, c->gens, (unsigned long)expected[got_count],
+               (unsigned long)got);
+        failures += !ok;
+        got_count++;
+    }
+    int status = pclose(js);
+    if (got_count < CONFIG_COUNT || status != 0)
+    {
+        printf("node devolveu %d de %d resultados\n", got_count, CONFIG_COUNT);
+        return 1;
+    }
+    printf("kernels C e JS: %d de %d configurações iguais\n", CONFIG_COUNT - failures, CONFIG_COUNT);
+    return failures ? 1 : 0;
+}
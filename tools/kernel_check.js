@@ -0,0 +1,34 @@
+// Lado JavaScript de tools/kernel_check.c: roda frontend/life.js nas mesmas
+// configurações e imprime o checksum de cada uma, uma por linha, em hex.
+//
+//   node kernel_check.js largura altura birth survive semente gerações [...]
+
+const path = require("path");
+const { lifeCreate, lifeStep, lifeChecksum } = require(path.join(__dirname, "..", "frontend", "life.js"));
+
+// xorshift32, igual ao do lado C
+function randomBoard(grid, seed) {
+  let s = seed >>> 0 || 1;
+  for (let y = 0; y < grid.height; y++)
+    for (let x = 0; x < grid.width; x++) {
+      s ^= s << 13;
+      s >>>= 0;
+      s ^= s >>> 17;
+      s ^= s << 5;
+      s >>>= 0;
+      if (s % 100 < 35) grid.cells[y * grid.stride + (x >>> 5)] |= 1 << (x & 31);
+    }
+}
+
+const args = process.argv.slice(2).map(Number);
+for (let i = 0; i + 6 <= args.length; i += 6) {
+  const [width, height, birth, survive, seed, gens] = args.slice(i, i + 6);
+  let cur = lifeCreate(width, height);
+  let next = lifeCreate(width, height);
+  randomBoard(cur, seed);
+  for (let g = 0; g < gens; g++) {
+    lifeStep(cur, next, { birth, survive });
+    [cur, next] = [next, cur];
+  }
+  console.log(lifeChecksum(cur).toString(16).padStart(8, "0"));
+}
@@ -0,0 +1,646 @@
+// Gerador de carga para a recepção de padrões (src/ingest.c): publica
+// padrões aleatórios em pico/life num broker e, numa segunda conexão
+// inscrita no mesmo tópico, passa o que chega pelo mesmo parser do firmware,
+// pedaço a pedaço como o lwIP entrega. Cada mensagem recebida é conferida
+// célula a célula contra a publicada; sai com 1 se alguma se perdeu.
+//
+//   mqtt_loadgen [-b broker] [-p porta] [-t tópico] [-n mensagens]
+//                [-c células] [-q qos] [-r mensagens/s]
+//   mqtt_loadgen -L [-n mensagens] [-c células] [-C pedaço]
+//
+// -L não usa rede: entrega os payloads em pedaços de 1..C bytes direto ao
+// parser e compara com o parser antigo (chunk_buffer + sscanf), para medir
+// só a CPU.
+//
+// O MQTT aqui é o mínimo do 3.1.1 para isso (CONNECT, SUBSCRIBE, PUBLISH
+// QoS 0/1, PUBACK), sem reconexão.
+
+#include "game.h"
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BOARD_CELLS (LIFE_GRID_WIDTH * LIFE_GRID_HEIGHT)
+#define MAX_PAYLOAD (BOARD_CELLS * 10 + 2) // "[ddd,dd]," por célula
+#define IDLE_TIMEOUT_S 3.0
+
+static const char *broker = "127.0.0.1";
+static const char *port = "1883";
+static const char *topic = "pico/life";
+static int messages = 1000;
+static int cells_per_message = 500;
+static int qos = 0;
+static int rate = 0; // mensagens/s, 0 = o mais rápido possível
+static int max_chunk = 1460; // -L: maior pedaço entregue ao parser
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+// ---------- Padrões ----------
+
+// Mensagem i: cells_per_message células distintas, sorteadas com semente i;
+// o publicador e o conferente geram a mesma
+static int make_payload(int index, char *out, life_grid_t *grid)
+{
+    static __thread uint16_t order[BOARD_CELLS];
+    uint64_t state = 0x9E3779B97F4A7C15ull * (index + 1);
+    for (int i = 0; i < BOARD_CELLS; i++)
+        order[i] = i;
+
+    life_clear(grid);
+    int len = 0;
+    out[len++] = '[';
+    for (int i = 0; i < cells_per_message; i++)
+    {
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        int j = i + (int)((state >> 33) % (BOARD_CELLS - i));
+        uint16_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+
+        int x = order[i] % LIFE_GRID_WIDTH, y = order[i] / LIFE_GRID_WIDTH;
+        life_set(grid, x, y, true);
+        len += sprintf(out + len, "%s[%d,%d]", i ? "," : "", x, y);
+    }
+    out[len++] = ']';
+    return len;
+}
+
+// ---------- Parser antigo (só para o -L) ----------
+
+// Cópia do game_ingest de antes: descarta pedaços que não cabem no buffer e
+// perde a primeira coordenada do array externo
+#define OLD_REST_BUFFER_SIZE 64
+
+static void old_ingest(life_grid_t *grid, const uint8_t *data, int len, bool last,
+                       unsigned long *dropped_chunks)
+{
+    static char rest_buffer[OLD_REST_BUFFER_SIZE];
+    static int rest_len = 0;
+    static char chunk_buffer[OLD_REST_BUFFER_SIZE + 512];
+    int total_len = 0;
+
+    if (rest_len > 0)
+    {
+        memcpy(chunk_buffer, rest_buffer, rest_len);
+        total_len = rest_len;
+        rest_len = 0;
+    }
+    if (len + total_len < (int)sizeof(chunk_buffer))
+    {
+        memcpy(chunk_buffer + total_len, data, len);
+        total_len += len;
+        chunk_buffer[total_len] = '\0';
+    }
+    else
+    {
+        (*dropped_chunks)++;
+        return;
+    }
+
+    char *ptr = chunk_buffer;
+    while (1)
+    {
+        char *open = strchr(ptr, '[');
+        if (!open)
+            break;
+        char *close = strchr(open, ']');
+        if (!close)
+        {
+            int remaining = strlen(open);
+            if (remaining < OLD_REST_BUFFER_SIZE)
+            {
+                memcpy(rest_buffer, open, remaining);
+                rest_len = remaining;
+            }
+            else
+                rest_len = 0;
+            break;
+        }
+        int x, y;
+        if (sscanf(open, "[%d,%d]", &x, &y) == 2 && x >= 0 && x < LIFE_GRID_WIDTH && y >= 0 &&
+            y < LIFE_GRID_HEIGHT)
+            life_set(grid, x, y, true);
+        ptr = close + 1;
+    }
+    if (last)
+        rest_len = 0;
+}
+
+// ---------- Conferência ----------
+
+typedef struct {
+    life_grid_t got, want;
+    uint32_t got_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    uint32_t want_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    char payload[MAX_PAYLOAD];
+    int next;      // próxima mensagem esperada
+    int mismatched;
+} checker_t;
+
+static void checker_init(checker_t *c)
+{
+    life_grid_init(&c->got, c->got_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&c->want, c->want_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    c->next = 0;
+    c->mismatched = 0;
+}
+
+// Tabuleiro de uma mensagem recebida contra a publicada com o mesmo índice
+static void checker_check(checker_t *c)
+{
+    make_payload(c->next++, c->payload, &c->want);
+    if (memcmp(c->got_cells, c->want_cells, sizeof(c->got_cells)) != 0)
+    {
+        if (c->mismatched++ < 5)
+            printf("DIVERGIU: mensagem %d, %d células recebidas de %d\n", c->next - 1,
+                   life_population(&c->got), life_population(&c->want));
+    }
+    life_clear(&c->got);
+}
+
+// ---------- Modo local ----------
+
+static int run_local(void)
+{
+    static checker_t check;
+    static char payload[MAX_PAYLOAD];
+    static uint32_t staging_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    static uint32_t old_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    ingest_t in;
+    life_grid_t old;
+    ingest_init(&in, staging_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    life_grid_init(&old, old_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    checker_init(&check);
+
+    double new_s = 0, old_s = 0;
+    uint64_t bytes = 0, old_cells_total = 0;
+    unsigned long old_dropped = 0;
+    srand(1);
+    for (int m = 0; m < messages; m++)
+    {
+        int len = make_payload(m, payload, &check.want);
+        bytes += len;
+
+        // Os mesmos cortes para os dois parsers
+        static int cuts[MAX_PAYLOAD];
+        int ncuts = 0;
+        for (int off = 0; off < len;)
+        {
+            int n = 1 + rand() % max_chunk;
+            off = off + n < len ? off + n : len;
+            cuts[ncuts++] = off;
+        }
+
+        double t0 = now_s();
+        ingest_begin(&in, len);
+        for (int i = 0, off = 0; i < ncuts; off = cuts[i++])
+            ingest_feed(&in, (const uint8_t *)payload + off, cuts[i] - off);
+        ingest_commit(&in, &check.got);
+        double t1 = now_s();
+        for (int i = 0, off = 0; i < ncuts; off = cuts[i++])
+            old_ingest(&old, (const uint8_t *)payload + off, cuts[i] - off, i == ncuts - 1,
+                       &old_dropped);
+        double t2 = now_s();
+        new_s += t1 - t0;
+        old_s += t2 - t1;
+
+        old_cells_total += life_population(&old);
+        life_clear(&old);
+        check.next = m;
+        checker_check(&check);
+    }
+
+    uint64_t sent = (uint64_t)messages * cells_per_message;
+    printf("conferência: %d mensagens, %d divergências, %lu descartadas\n", messages,
+           check.mismatched, (unsigned long)in.stats.dropped);
+    printf("%-8s %8.1f MB/s  %8.2f M células/s  %llu de %llu células\n", "novo",
+           bytes / new_s / 1e6, in.stats.cells / new_s / 1e6,
+           (unsigned long long)in.stats.cells, (unsigned long long)sent);
+    printf("%-8s %8.1f MB/s  %8.2f M células/s  %llu de %llu células, %lu pedaços descartados\n",
+           "antigo", bytes / old_s / 1e6, old_cells_total / old_s / 1e6,
+           (unsigned long long)old_cells_total, (unsigned long long)sent, old_dropped);
+    return check.mismatched || in.stats.cells != sent ? 1 : 0;
+}
+
+// ---------- MQTT ----------
+
+static int put_length(uint8_t *p, uint32_t len)
+{
+    int n = 0;
+    do
+    {
+        uint8_t b = len % 128;
+        len /= 128;
+        p[n++] = b | (len ? 0x80 : 0);
+    } while (len);
+    return n;
+}
+
+static int put_string(uint8_t *p, const char *s)
+{
+    int len = strlen(s);
+    p[0] = len >> 8;
+    p[1] = len & 0xFF;
+    memcpy(p + 2, s, len);
+    return 2 + len;
+}
+
+static bool send_all(int fd, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    while (len)
+    {
+        ssize_t n = send(fd, p, len, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+static bool recv_all(int fd, void *data, size_t len)
+{
+    uint8_t *p = data;
+    while (len)
+    {
+        ssize_t n = recv(fd, p, len, 0);
+        if (n <= 0)
+            return false;
+        p += n;
+        len -= n;
+    }
+    return true;
+}
+
+// Conecta e espera o CONNACK; -1 em erro
+static int mqtt_open(const char *client_id)
+{
+    struct addrinfo hints = { .ai_family = AF_UNSPEC, .ai_socktype = SOCK_STREAM }, *res;
+    if (getaddrinfo(broker, port, &hints, &res) != 0)
+        return -1;
+    int fd = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
+    if (fd < 0 || connect(fd, res->ai_addr, res->ai_addrlen) != 0)
+    {
+        freeaddrinfo(res);
+        if (fd >= 0)
+            close(fd);
+        return -1;
+    }
+    freeaddrinfo(res);
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    uint8_t body[128], pkt[140];
+    int len = put_string(body, "MQTT");
+    body[len++] = 4;    // 3.1.1
+    body[len++] = 0x02; // clean session
+    body[len++] = 0;
+    body[len++] = 60;   // keep alive
+    len += put_string(body + len, client_id);
+    int n = 0;
+    pkt[n++] = 0x10;
+    n += put_length(pkt + n, len);
+    memcpy(pkt + n, body, len);
+
+    uint8_t ack[4];
+    if (!send_all(fd, pkt, n + len) || !recv_all(fd, ack, 4) || ack[0] != 0x20 || ack[3] != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// ---------- Assinante ----------
+
+// Lê os pacotes do socket como chegam e passa o payload dos PUBLISH ao
+// parser em pedaços, sem esperar a mensagem inteira
+typedef enum {
+    RX_TYPE,
+    RX_LENGTH,
+    RX_HEADER, // tópico e packet id
+    RX_PAYLOAD,
+    RX_SKIP,
+} rx_state_t;
+
+typedef struct {
+    int fd;
+    ingest_t in;
+    uint32_t staging_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    checker_t check;
+
+    rx_state_t state;
+    uint8_t type;
+    uint32_t remaining, multiplier;
+    uint8_t header[512];
+    uint32_t header_len, header_need;
+    bool wrong_topic;
+
+    double first_s, last_s, busy_s;
+    volatile bool ready;
+    volatile bool stop;
+} subscriber_t;
+
+static void packet_start(subscriber_t *s)
+{
+    if ((s->type >> 4) == 3)
+    {
+        s->state = RX_HEADER;
+        s->header_len = 0;
+        s->header_need = 2;
+    }
+    else
+        s->state = s->remaining ? RX_SKIP : RX_TYPE;
+}
+
+// Consome bytes de um recv(); devolve false se a conexão deve fechar
+static bool subscriber_rx(subscriber_t *s, const uint8_t *p, size_t n)
+{
+    while (n)
+    {
+        switch (s->state)
+        {
+        case RX_TYPE:
+            s->type = *p++;
+            n--;
+            s->remaining = 0;
+            s->multiplier = 1;
+            s->state = RX_LENGTH;
+            break;
+
+        case RX_LENGTH:
+            s->remaining += (*p & 0x7F) * s->multiplier;
+            s->multiplier *= 128;
+            if (!(*p++ & 0x80))
+                packet_start(s);
+            n--;
+            break;
+
+        case RX_HEADER:
+        {
+            // Tamanho do tópico (2), tópico, packet id (2 se QoS > 0)
+            uint8_t b = *p++;
+            n--;
+            s->remaining--;
+            if (s->header_len < sizeof(s->header))
+                s->header[s->header_len] = b;
+            s->header_len++;
+            if (s->header_len == 2)
+                s->header_need = 2 + ((s->header[0] << 8) | s->header[1]) +
+                                 (((s->type >> 1) & 3) ? 2 : 0);
+            if (s->header_len < s->header_need)
+                break;
+
+            uint32_t topic_len = s->header_need - 2 - (((s->type >> 1) & 3) ? 2 : 0);
+            s->wrong_topic = topic_len != strlen(topic) || s->header_need > sizeof(s->header) ||
+                             memcmp(s->header + 2, topic, topic_len) != 0;
+            if (((s->type >> 1) & 3) == 1)
+            {
+                uint8_t ack[4] = { 0x40, 2, s->header[s->header_need - 2], s->header[s->header_need - 1] };
+                if (!send_all(s->fd, ack, 4))
+                    return false;
+            }
+            if (!s->wrong_topic)
+            {
+                if (!s->first_s)
+                    s->first_s = now_s();
+                ingest_begin(&s->in, s->remaining);
+            }
+            s->state = RX_PAYLOAD;
+            if (s->remaining == 0 && !s->wrong_topic)
+            {
+                ingest_commit(&s->in, &s->check.got);
+                checker_check(&s->check);
+                s->state = RX_TYPE;
+            }
+            break;
+        }
+
+        case RX_PAYLOAD:
+        case RX_SKIP:
+        {
+            size_t take = n < s->remaining ? n : s->remaining;
+            bool last = take == s->remaining;
+            if (s->state == RX_PAYLOAD && !s->wrong_topic)
+            {
+                double t0 = now_s();
+                ingest_feed(&s->in, p, take);
+                if (last)
+                {
+                    ingest_commit(&s->in, &s->check.got);
+                    s->last_s = now_s();
+                }
+                s->busy_s += now_s() - t0;
+                if (last)
+                    checker_check(&s->check);
+            }
+            p += take;
+            n -= take;
+            s->remaining -= take;
+            if (last)
+                s->state = RX_TYPE;
+            break;
+        }
+        }
+    }
+    return true;
+}
+
+static void *subscriber_main(void *arg)
+{
+    subscriber_t *s = arg;
+    static uint8_t buf[16 * 1024];
+
+    uint8_t pkt[300];
+    int n = 0, len = 0;
+    uint8_t body[280];
+    body[len++] = 0;
+    body[len++] = 1; // packet id
+    len += put_string(body + len, topic);
+    body[len++] = qos;
+    pkt[n++] = 0x82;
+    n += put_length(pkt + n, len);
+    memcpy(pkt + n, body, len);
+    if (!send_all(s->fd, pkt, n + len))
+        return NULL;
+
+    // SUBACK: 0x90 3 id id qos
+    uint8_t ack[5];
+    if (!recv_all(s->fd, ack, 5) || ack[0] != 0x90 || ack[4] == 0x80)
+    {
+        printf("broker recusou a inscrição em %s\n", topic);
+        return NULL;
+    }
+    s->ready = true;
+
+    struct timeval tv = { .tv_sec = 0, .tv_usec = 200000 };
+    setsockopt(s->fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    while (!s->stop)
+    {
+        ssize_t got = recv(s->fd, buf, sizeof(buf), 0);
+        if (got == 0)
+            break;
+        if (got > 0 && !subscriber_rx(s, buf, got))
+            break;
+    }
+    return NULL;
+}
+
+// ---------- Publicador ----------
+
+static int run_broker(void)
+{
+    static subscriber_t sub;
+    static char payload[MAX_PAYLOAD];
+    static uint32_t scratch_cells[LIFE_GRID_WORDS(LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT)];
+    life_grid_t scratch;
+    life_grid_init(&scratch, scratch_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+
+    char id[32];
+    snprintf(id, sizeof(id), "loadgen-sub-%d", (int)getpid());
+    sub.fd = mqtt_open(id);
+    snprintf(id, sizeof(id), "loadgen-pub-%d", (int)getpid());
+    int pub = mqtt_open(id);
+    if (sub.fd < 0 || pub < 0)
+    {
+        printf("não deu para conectar em %s:%s\n", broker, port);
+        return 1;
+    }
+    ingest_init(&sub.in, sub.staging_cells, LIFE_GRID_WIDTH, LIFE_GRID_HEIGHT);
+    checker_init(&sub.check);
+
+    pthread_t thread;
+    pthread_create(&thread, NULL, subscriber_main, &sub);
+    while (!sub.ready)
+        usleep(1000);
+
+    uint64_t bytes = 0;
+    uint16_t packet_id = 0;
+    double start = now_s();
+    for (int m = 0; m < messages; m++)
+    {
+        int len = make_payload(m, payload, &scratch);
+        bytes += len;
+
+        uint8_t head[300];
+        int n = 0, topic_len = strlen(topic);
+        head[n++] = 0x30 | (qos << 1);
+        n += put_length(head + n, 2 + topic_len + (qos ? 2 : 0) + len);
+        n += put_string(head + n, topic);
+        if (qos)
+        {
+            packet_id = packet_id == 0xFFFF ? 1 : packet_id + 1;
+            head[n++] = packet_id >> 8;
+            head[n++] = packet_id & 0xFF;
+        }
+        struct iovec iov[2] = { { head, n }, { payload, len } };
+        struct msghdr msg = { .msg_iov = iov, .msg_iovlen = 2 };
+        ssize_t sent = sendmsg(pub, &msg, MSG_NOSIGNAL);
+        if (sent >= 0 && sent < n)
+            sent = send_all(pub, head + sent, n - sent) ? n : -1;
+        if (sent < n || !send_all(pub, payload + (sent - n), len - (sent - n)))
+        {
+            printf("publicação falhou na mensagem %d\n", m);
+            break;
+        }
+
+        // PUBACKs do QoS 1: só drena, o broker não espera por eles
+        if (qos)
+        {
+            uint8_t acks[4096];
+            while (recv(pub, acks, sizeof(acks), MSG_DONTWAIT) > 0)
+                ;
+        }
+        if (rate)
+        {
+            double due = start + (double)(m + 1) / rate;
+            while (now_s() < due)
+                usleep(100);
+        }
+    }
+    double pub_s = now_s() - start;
+    uint8_t disconnect[2] = { 0xE0, 0 };
+    send_all(pub, disconnect, 2);
+
+    // Espera o assinante alcançar ou ficar parado IDLE_TIMEOUT_S
+    int seen = -1;
+    double idle_since = now_s();
+    while (sub.check.next < messages && now_s() - idle_since < IDLE_TIMEOUT_S)
+    {
+        if (sub.check.next != seen)
+        {
+            seen = sub.check.next;
+            idle_since = now_s();
+        }
+        usleep(10000);
+    }
+    sub.stop = true;
+    pthread_join(thread, NULL);
+    send_all(sub.fd, disconnect, 2);
+    close(sub.fd);
+    close(pub);
+
+    const ingest_stats_t *st = &sub.in.stats;
+    double span = sub.last_s - sub.first_s;
+    int lost = messages - sub.check.next;
+    printf("publicado: %d mensagens de %d células, %.1f MB em %.2f s (%.0f mensagens/s)\n",
+           messages, cells_per_message, bytes / 1e6, pub_s, messages / pub_s);
+    printf("recebido:  %lu mensagens, %.2f MB/s, %.3f M células/s, parser %.1f%% do tempo\n",
+           (unsigned long)st->messages, span > 0 ? st->bytes / span / 1e6 : 0,
+           span > 0 ? st->cells / span / 1e6 : 0, span > 0 ? 100.0 * sub.busy_s / span : 0);
+    printf("perdas: %d mensagens não chegaram, %d divergiram, %lu descartadas, "
+           "%lu fora do tabuleiro, %lu inválidas\n",
+           lost, sub.check.mismatched, (unsigned long)st->dropped,
+           (unsigned long)st->out_of_range, (unsigned long)st->malformed);
+    return lost || sub.check.mismatched || st->dropped ? 1 : 0;
+}
+
+int main(int argc, char **argv)
+{
+    bool local = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "b:p:t:n:c:q:r:LC:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'b': broker = optarg; break;
+        case 'p': port = optarg; break;
+        case 't': topic = optarg; break;
+        case 'n': messages = atoi(optarg); break;
+        case 'c': cells_per_message = atoi(optarg); break;
+        case 'q': qos = atoi(optarg) ? 1 : 0; break;
+        case 'r': rate = atoi(optarg); break;
+        case 'L': local = true; break;
+        case 'C': max_chunk = atoi(optarg); break;
+        default:
+            fprintf(stderr,
+                    "uso: %s [-b broker] [-p porta] [-t tópico] [-n mensagens] [-c células]"
+                    " [-q qos] [-r mensagens/s]\n"
+                    "     %s -L [-n mensagens] [-c células] [-C pedaço]\n",
+                    argv[0], argv[0]);
+            return 2;
+        }
+    }
+    if (messages < 1 || cells_per_message < 1 || cells_per_message > BOARD_CELLS ||
+        max_chunk < 1 || strlen(topic) > 250)
+    {
+        fprintf(stderr, "parâmetros fora do intervalo (células: 1..%d)\n", BOARD_CELLS);
+        return 2;
+    }
+    return local ? run_local() : run_broker();
+}
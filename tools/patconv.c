@@ -0,0 +1,868 @@
+// Conversão de padrões do Golly (RLE e Macrocell) para o payload de pico/life
+// e de volta, usando tools/pattern.c.
+//
+//   patconv [-t] [-W largura] [-H altura] [-x x0] [-y y0] [-o saída] padrão
+//   patconv -r [-o saída.rle] captura
+//   patconv -B [-n repetições] padrão
+//   patconv -G lado [-M] [-o saída]
+//
+// Sem -t o padrão é recortado numa janela do tamanho do tabuleiro do jogo
+// (centrada no padrão, ou em -x/-y) e sai um payload "[[x,y],...]".
+// Com -t o padrão é cortado em tiles do modo distribuído (128x64), um
+// arquivo <saída>-<coluna>-<linha>.json por tile não vazio.
+// Arquivos são lidos com mmap e "-" lê da entrada padrão em pedaços.
+//
+// -r converte de volta para RLE: payload de pico/life, captura do lockstep
+// (mosquitto_sub -v -t pico/life/lockstep, usa o último snapshot completo)
+// ou um framebuffer do SSD1306 de 1024 bytes. Sai só a caixa das células
+// vivas; o canto dela no tabuleiro vai no comentário.
+// -B mede a leitura (mmap inteiro e read() em pedaços de 64 KiB) depois de
+// conferir que pedaços de tamanho aleatório dão o mesmo resultado.
+// -G gera uma sopa aleatória lado x lado em RLE (ou Macrocell com -M), para
+// ter arquivos grandes para o -B.
+
+#include "pattern.h"
+#include "game.h"
+#include "dist.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define READ_CHUNK (64 * 1024)
+#define MAX_TILE_COLS 4096
+
+// ---------- Entrada ----------
+
+typedef struct {
+    const char *data; // mmap, ou o primeiro pedaço lido
+    size_t len;
+    int fd;
+    bool mapped;
+} input_t;
+
+static bool input_open(input_t *in, const char *path, bool map)
+{
+    static char head[READ_CHUNK];
+    memset(in, 0, sizeof(*in));
+    in->fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (in->fd < 0)
+        return false;
+    struct stat st;
+    if (map && fstat(in->fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0)
+    {
+        void *m = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, in->fd, 0);
+        if (m != MAP_FAILED)
+        {
+            madvise(m, st.st_size, MADV_SEQUENTIAL);
+            in->data = m;
+            in->len = st.st_size;
+            in->mapped = true;
+            return true;
+        }
+    }
+    // Sem mmap (entrada padrão, pipe): o começo já fica lido para detectar o formato
+    ssize_t n = read(in->fd, head, sizeof(head));
+    in->data = head;
+    in->len = n > 0 ? n : 0;
+    return true;
+}
+
+static void input_close(input_t *in)
+{
+    if (in->mapped)
+        munmap((void *)in->data, in->len);
+    if (in->fd != STDIN_FILENO)
+        close(in->fd);
+}
+
+// Passa só os comentários e o cabeçalho do RLE; devolve quantos bytes usou
+static size_t feed_header(pattern_parser_t *p, const char *data, size_t len)
+{
+    size_t used = 0;
+    while (used < len && !p->header_seen)
+    {
+        const char *nl = memchr(data + used, '\n', len - used);
+        size_t line = nl ? (size_t)(nl - (data + used)) + 1 : len - used;
+        char c = data[used];
+        if (!nl || (c != '#' && c != 'x' && c != '\n' && c != '\r'))
+            break;
+        pattern_feed(p, data + used, line);
+        used += line;
+    }
+    return used;
+}
+
+// Passa o arquivo todo pelo parser: com mmap num pedaço só, senão em pedaços
+// de 64 KiB. on_header roda entre o cabeçalho e o corpo, para ajustar a janela
+static bool parse_input(input_t *in, pattern_parser_t *p,
+                        void (*on_header)(pattern_parser_t *p, void *ctx), void *ctx)
+{
+    size_t used = 0;
+    if (on_header)
+    {
+        used = feed_header(p, in->data, in->len);
+        on_header(p, ctx);
+    }
+    pattern_feed(p, in->data + used, in->len - used);
+    if (!in->mapped)
+    {
+        static char buf[READ_CHUNK];
+        ssize_t n;
+        while (!p->done && !p->failed && (n = read(in->fd, buf, sizeof(buf))) > 0)
+            pattern_feed(p, buf, n);
+    }
+    return !p->failed && pattern_finish(p);
+}
+
+// Arquivo pequeno inteiro na memória (capturas do -r)
+static char *read_all(const char *path, size_t *len)
+{
+    int fd = strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    size_t cap = READ_CHUNK, n = 0;
+    char *buf = malloc(cap + 1);
+    ssize_t r;
+    while ((r = read(fd, buf + n, cap - n)) > 0)
+        if ((n += r) == cap)
+            buf = realloc(buf, (cap *= 2) + 1);
+    if (fd != STDIN_FILENO)
+        close(fd);
+    buf[n] = '\0';
+    *len = n;
+    return buf;
+}
+
+// ---------- Tiles ----------
+
+// Uma linha de tiles em memória por vez; o RLE chega em ordem de linha e o
+// Macrocell é expandido uma faixa por vez, então a memória não depende da
+// altura do padrão
+typedef struct {
+    int tile_w, tile_h;
+    int64_t x0, y0;
+    int cols, rows;
+    int band;
+    life_grid_t *tiles;
+    uint32_t *cells;
+    bool *used;
+    const char *out; // arquivo (recorte) ou prefixo (tiles)
+    bool tiled;
+    bool has_origin; // -x/-y; senão a partir da caixa do padrão
+    int files;
+    uint64_t cells_out;
+} sink_t;
+
+static void set_run(life_grid_t *grid, int x, int y, int len)
+{
+    uint32_t *row = life_row(grid, y);
+    while (len > 0)
+    {
+        int bit = x % LIFE_WORD_BITS;
+        int n = LIFE_WORD_BITS - bit < len ? LIFE_WORD_BITS - bit : len;
+        uint32_t mask = n == LIFE_WORD_BITS ? 0xFFFFFFFFu : ((1u << n) - 1u) << bit;
+        row[x / LIFE_WORD_BITS] |= mask;
+        x += n;
+        len -= n;
+    }
+}
+
+static void write_payload(FILE *f, const life_grid_t *grid)
+{
+    bool first = true;
+    fputc('[', f);
+    for (int y = 0; y < grid->height; y++)
+    {
+        const uint32_t *row = life_row(grid, y);
+        for (int w = 0; w < grid->stride; w++)
+            for (uint32_t bits = row[w]; bits; bits &= bits - 1)
+            {
+                fprintf(f, "%s[%d,%d]", first ? "" : ",", w * LIFE_WORD_BITS + __builtin_ctz(bits), y);
+                first = false;
+            }
+    }
+    fputs("]\n", f);
+}
+
+static void flush_band(sink_t *s)
+{
+    if (s->band < 0)
+        return;
+    for (int c = 0; c < s->cols; c++)
+    {
+        if (!s->used[c] && s->tiled)
+            continue;
+        life_grid_t *tile = &s->tiles[c];
+        FILE *f = stdout;
+        char path[512];
+        if (s->tiled)
+            snprintf(path, sizeof(path), "%s-%d-%d.json", s->out, c, s->band);
+        if (s->tiled || s->out)
+        {
+            f = fopen(s->tiled ? path : s->out, "w");
+            if (!f)
+            {
+                fprintf(stderr, "%s: não deu para criar\n", s->tiled ? path : s->out);
+                continue;
+            }
+        }
+        write_payload(f, tile);
+        if (f != stdout)
+            fclose(f);
+        s->files++;
+        s->cells_out += life_population(tile);
+        life_clear(tile);
+        s->used[c] = false;
+    }
+    s->band = -1;
+}
+
+static void sink_span(void *ctx, int64_t x, int64_t y, int64_t len)
+{
+    sink_t *s = ctx;
+    int64_t rx = x - s->x0, ry = y - s->y0;
+    int band = (int)(ry / s->tile_h);
+    if (band != s->band)
+    {
+        flush_band(s);
+        s->band = band;
+    }
+    int ty = (int)(ry % s->tile_h);
+    while (len > 0)
+    {
+        int c = (int)(rx / s->tile_w), tx = (int)(rx % s->tile_w);
+        int n = s->tile_w - tx < len ? s->tile_w - tx : (int)len;
+        set_run(&s->tiles[c], tx, ty, n);
+        s->used[c] = true;
+        rx += n;
+        len -= n;
+    }
+}
+
+// Posiciona os tiles (ou o recorte) sobre a caixa do padrão
+static bool sink_setup(sink_t *s, pattern_box_t box)
+{
+    if (s->tiled)
+    {
+        if (!s->has_origin)
+        {
+            s->x0 = box.x;
+            s->y0 = box.y;
+        }
+        int64_t cols = (box.x + box.width - s->x0 + s->tile_w - 1) / s->tile_w;
+        int64_t rows = (box.y + box.height - s->y0 + s->tile_h - 1) / s->tile_h;
+        s->cols = cols > 1 ? (int)(cols < MAX_TILE_COLS ? cols : MAX_TILE_COLS) : 1;
+        // Sem cabeçalho o RLE não diz a altura: segue até o fim do arquivo
+        s->rows = box.height ? (rows > 1 ? (int)rows : 1) : INT32_MAX / s->tile_h;
+        if (cols > MAX_TILE_COLS)
+            fprintf(stderr, "aviso: só as primeiras %d colunas de tiles\n", MAX_TILE_COLS);
+    }
+    else
+    {
+        if (!s->has_origin)
+        {
+            s->x0 = box.x + (box.width - s->tile_w) / 2;
+            s->y0 = box.y + (box.height - s->tile_h) / 2;
+        }
+        s->cols = s->rows = 1;
+    }
+
+    size_t words = LIFE_GRID_WORDS(s->tile_w, s->tile_h);
+    s->tiles = calloc(s->cols, sizeof(life_grid_t));
+    s->cells = calloc((size_t)s->cols * words, sizeof(uint32_t));
+    s->used = calloc(s->cols, sizeof(bool));
+    if (!s->tiles || !s->cells || !s->used)
+        return false;
+    for (int c = 0; c < s->cols; c++)
+        life_grid_init(&s->tiles[c], s->cells + (size_t)c * words, s->tile_w, s->tile_h);
+    return true;
+}
+
+static void rle_header(pattern_parser_t *p, void *ctx)
+{
+    sink_t *s = ctx;
+    if (!sink_setup(s, pattern_bounds(p)))
+    {
+        p->failed = true;
+        snprintf(p->error, sizeof(p->error), "sem memória para os tiles");
+        return;
+    }
+    pattern_set_window(p, s->x0, s->y0, (int64_t)s->cols * s->tile_w, (int64_t)s->rows * s->tile_h);
+}
+
+static int import_pattern(const char *path, sink_t *s)
+{
+    input_t in;
+    if (!input_open(&in, path, true))
+    {
+        fprintf(stderr, "%s: não deu para abrir\n", path);
+        return 1;
+    }
+    pattern_format_t format = pattern_detect(path, in.data, in.len);
+    pattern_parser_t p;
+    pattern_parser_init(&p, format, sink_span, s);
+
+    bool ok;
+    pattern_box_t box;
+    if (format == PATTERN_MACROCELL)
+    {
+        // A árvore só tem caixa depois de lida inteira; aí expande faixa por
+        // faixa de tiles
+        pattern_set_window(&p, 0, 0, 0, 0);
+        ok = parse_input(&in, &p, NULL, NULL);
+        box = pattern_bounds(&p);
+        ok = ok && sink_setup(s, box);
+        for (int band = 0; ok && band < s->rows; band++)
+        {
+            pattern_set_window(&p, s->x0, s->y0 + (int64_t)band * s->tile_h,
+                               (int64_t)s->cols * s->tile_w, s->tile_h);
+            pattern_expand(&p);
+            if (!s->tiled)
+                s->band = 0; // o recorte sai mesmo vazio
+            flush_band(s);
+        }
+    }
+    else
+    {
+        ok = parse_input(&in, &p, rle_header, s);
+        box = pattern_bounds(&p);
+        if (ok && !s->tiled)
+            s->band = 0;
+        flush_band(s);
+    }
+
+    if (!ok)
+        fprintf(stderr, "%s: %s\n", path, p.error[0] ? p.error : "erro de leitura");
+    else
+    {
+        char rule[LIFE_RULE_TEXT_MAX];
+        life_format_rule(p.rule, rule, sizeof(rule));
+        fprintf(stderr, "%s: %s %lldx%lld, regra %s, %llu células lidas, %llu na saída, %d %s\n",
+                path, format == PATTERN_MACROCELL ? "Macrocell" : "RLE", (long long)box.width,
+                (long long)box.height, rule, (unsigned long long)p.cells,
+                (unsigned long long)s->cells_out, s->files, s->tiled ? "tiles" : "payload");
+        if (p.rule.birth != life_rule.birth || p.rule.survive != life_rule.survive ||
+            p.rule.states != life_rule.states)
+            fprintf(stderr, "aviso: a regra do padrão não é a do firmware\n");
+    }
+
+    pattern_parser_free(&p);
+    free(s->tiles);
+    free(s->cells);
+    free(s->used);
+    input_close(&in);
+    return ok ? 0 : 1;
+}
+
+// ---------- Volta para RLE ----------
+
+static life_grid_t *new_grid(int width, int height)
+{
+    life_grid_t *grid = malloc(sizeof(life_grid_t));
+    life_grid_init(grid, calloc(LIFE_GRID_WORDS(width, height) + 1, sizeof(uint32_t)), width, height);
+    return grid;
+}
+
+static void free_grid(life_grid_t *grid)
+{
+    if (grid)
+        free(grid->cells);
+    free(grid);
+}
+
+// Recorta na caixa das células vivas (0x0 se não houver nenhuma); devolve
+// um tabuleiro novo e o canto da caixa no original
+static life_grid_t *crop_to_live(const life_grid_t *grid, int *ox, int *oy)
+{
+    int x0 = grid->width, x1 = -1, y0 = grid->height, y1 = -1;
+    for (int y = 0; y < grid->height; y++)
+    {
+        const uint32_t *row = life_row(grid, y);
+        for (int w = 0; w < grid->stride; w++)
+        {
+            if (!row[w])
+                continue;
+            int lo = w * LIFE_WORD_BITS + __builtin_ctz(row[w]);
+            int hi = w * LIFE_WORD_BITS + LIFE_WORD_BITS - 1 - __builtin_clz(row[w]);
+            if (lo < x0)
+                x0 = lo;
+            if (hi > x1)
+                x1 = hi;
+            if (y < y0)
+                y0 = y;
+            y1 = y;
+        }
+    }
+    if (x1 < 0)
+    {
+        *ox = *oy = 0;
+        return new_grid(0, 0);
+    }
+
+    life_grid_t *out = new_grid(x1 - x0 + 1, y1 - y0 + 1);
+    int shift = x0 % LIFE_WORD_BITS;
+    for (int y = y0; y <= y1; y++)
+    {
+        const uint32_t *src = life_row(grid, y) + x0 / LIFE_WORD_BITS;
+        int avail = grid->stride - x0 / LIFE_WORD_BITS;
+        uint32_t *dst = life_row(out, y - y0);
+        for (int w = 0; w < out->stride; w++)
+        {
+            uint32_t v = w < avail ? src[w] >> shift : 0;
+            if (shift && w + 1 < avail)
+                v |= src[w + 1] << (LIFE_WORD_BITS - shift);
+            dst[w] = v;
+        }
+        int tail = out->width % LIFE_WORD_BITS;
+        if (tail)
+            dst[out->stride - 1] &= (1u << tail) - 1;
+    }
+    *ox = x0;
+    *oy = y0;
+    return out;
+}
+
+// Framebuffer em páginas do SSD1306 -> 128x64
+static life_grid_t *from_framebuffer(const uint8_t *buf)
+{
+    life_grid_t *grid = new_grid(ssd1306_width, ssd1306_height);
+    for (int y = 0; y < ssd1306_height; y++)
+        for (int x = 0; x < ssd1306_width; x++)
+            if ((buf[(y / 8) * ssd1306_width + x] >> (y % 8)) & 1u)
+                life_set(grid, x, y, true);
+    return grid;
+}
+
+// Último snapshot completo (H, S..., E) de uma captura do lockstep
+static life_grid_t *from_lockstep(char *text, life_rule_t *rule, unsigned long *gen)
+{
+    life_grid_t *building = NULL, *done = NULL;
+    life_rule_t building_rule = LIFE_RULE_CONWAY;
+    unsigned long building_gen = 0;
+
+    for (char *line = strtok(text, "\r\n"); line; line = strtok(NULL, "\r\n"))
+    {
+        // mosquitto_sub -v põe o tópico antes
+        char *msg = line;
+        char *space = strchr(line, ' ');
+        if (space && memchr(line, '/', space - line))
+            msg = space + 1;
+
+        if (msg[0] == 'H' && msg[1] == ' ')
+        {
+            int w, h;
+            char rule_text[24];
+            if (sscanf(msg, "H %lu %d %d %23s", &building_gen, &w, &h, rule_text) != 4 ||
+                w <= 0 || h <= 0 || w > 65535 || h > 65535)
+                continue;
+            free_grid(building);
+            building = new_grid(w, h);
+            if (!life_parse_rule(rule_text, &building_rule))
+                building_rule = LIFE_RULE_CONWAY;
+        }
+        else if (msg[0] == 'S' && msg[1] == ' ' && building)
+        {
+            int row;
+            char *hex = msg + 2;
+            row = (int)strtol(hex, &hex, 10);
+            while (*hex == ' ')
+                hex++;
+            for (int y = row; y < building->height && hex[0]; y++)
+                for (int w = 0; w < building->stride && strlen(hex) >= 8; w++, hex += 8)
+                {
+                    char word[9];
+                    memcpy(word, hex, 8);
+                    word[8] = '\0';
+                    life_row(building, y)[w] = (uint32_t)strtoul(word, NULL, 16);
+                }
+        }
+        else if (msg[0] == 'E' && msg[1] == ' ' && building)
+        {
+            unsigned long egen, sum;
+            if (sscanf(msg, "E %lu %lx", &egen, &sum) == 2 && egen == building_gen &&
+                life_checksum(building) == (uint32_t)sum)
+            {
+                free_grid(done);
+                done = building;
+                building = NULL;
+                *rule = building_rule;
+                *gen = building_gen;
+            }
+        }
+    }
+    free_grid(building);
+    return done;
+}
+
+// Payload "[[x,y],...]" num tabuleiro do tamanho da maior coordenada
+static life_grid_t *from_payload(const char *text)
+{
+    int max_x = -1, max_y = -1;
+    for (int pass = 0; pass < 2; pass++)
+    {
+        life_grid_t *grid = pass ? new_grid(max_x + 1, max_y + 1) : NULL;
+        const char *p = text;
+        while ((p = strchr(p, '[')))
+        {
+            int x, y;
+            p++;
+            if (sscanf(p, "%d , %d ]", &x, &y) != 2 || x < 0 || y < 0 || x > 65534 || y > 65534)
+                continue;
+            if (!pass)
+            {
+                if (x > max_x) max_x = x;
+                if (y > max_y) max_y = y;
+            }
+            else
+                life_set(grid, x, y, true);
+        }
+        if (pass)
+            return grid;
+        if (max_x < 0)
+            return NULL;
+    }
+    return NULL;
+}
+
+static int export_rle(const char *path, const char *out_path)
+{
+    size_t len;
+    char *text = read_all(path, &len);
+    if (!text)
+    {
+        fprintf(stderr, "%s: não deu para abrir\n", path);
+        return 1;
+    }
+
+    life_grid_t *grid;
+    life_rule_t rule = life_rule;
+    unsigned long gen = 0;
+    char comment[128];
+    if (len == ssd1306_buffer_length && memchr(text, '\0', len))
+    {
+        grid = from_framebuffer((const uint8_t *)text);
+        snprintf(comment, sizeof(comment), "framebuffer do SSD1306 (%s)", path);
+    }
+    else if (strstr(text, "H ") && strstr(text, "E "))
+    {
+        grid = from_lockstep(text, &rule, &gen);
+        snprintf(comment, sizeof(comment), "lockstep, geração %lu", gen);
+    }
+    else
+    {
+        grid = from_payload(text);
+        snprintf(comment, sizeof(comment), "payload de pico/life (%s)", path);
+    }
+    free(text);
+    if (!grid)
+    {
+        fprintf(stderr, "%s: nenhum padrão encontrado\n", path);
+        return 1;
+    }
+
+    // Só a caixa das células vivas, como o Golly grava
+    int ox, oy;
+    life_grid_t *cropped = crop_to_live(grid, &ox, &oy);
+    free_grid(grid);
+    grid = cropped;
+    size_t used = strlen(comment);
+    snprintf(comment + used, sizeof(comment) - used, ", canto em (%d, %d)", ox, oy);
+
+    FILE *f = out_path ? fopen(out_path, "w") : stdout;
+    if (!f)
+    {
+        fprintf(stderr, "%s: não deu para criar\n", out_path);
+        free_grid(grid);
+        return 1;
+    }
+    pattern_write_rle(f, grid, rule, comment);
+    if (f != stdout)
+        fclose(f);
+    fprintf(stderr, "%dx%d, %d células\n", grid->width, grid->height, life_population(grid));
+    free_grid(grid);
+    return 0;
+}
+
+// ---------- Medição ----------
+
+typedef struct {
+    uint64_t cells, spans, hash;
+} count_t;
+
+static void count_span(void *ctx, int64_t x, int64_t y, int64_t len)
+{
+    count_t *c = ctx;
+    c->cells += len;
+    c->spans++;
+    c->hash += (uint64_t)(x * 0x9E3779B97F4A7C15ull) ^ (uint64_t)(y * 0xC2B2AE3D27D4EB4Full) ^ len;
+}
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int benchmark(const char *path, int repeats)
+{
+    input_t in;
+    if (!input_open(&in, path, true) || !in.mapped)
+    {
+        fprintf(stderr, "%s: -B precisa de um arquivo comum\n", path);
+        return 1;
+    }
+    pattern_format_t format = pattern_detect(path, in.data, in.len);
+
+    // Referência: o arquivo num pedaço só
+    count_t ref = {0};
+    pattern_parser_t p;
+    pattern_parser_init(&p, format, count_span, &ref);
+    if (!parse_input(&in, &p, NULL, NULL))
+    {
+        fprintf(stderr, "%s: %s\n", path, p.error);
+        return 1;
+    }
+    pattern_parser_free(&p);
+
+    // Pedaços de tamanho aleatório, cortando tokens e linhas no meio
+    srand(1);
+    for (int trial = 0; trial < 3; trial++)
+    {
+        count_t got = {0};
+        pattern_parser_init(&p, format, count_span, &got);
+        for (size_t off = 0; off < in.len && !p.done;)
+        {
+            size_t n = 1 + rand() % (trial == 0 ? 7 : 4096);
+            if (n > in.len - off)
+                n = in.len - off;
+            pattern_feed(&p, in.data + off, n);
+            off += n;
+        }
+        bool ok = pattern_finish(&p);
+        pattern_parser_free(&p);
+        if (!ok || got.cells != ref.cells || got.spans != ref.spans || got.hash != ref.hash)
+        {
+            printf("DIVERGIU: pedaços aleatórios (rodada %d) deram outro resultado\n", trial);
+            return 1;
+        }
+    }
+    printf("conferência: pedaços aleatórios iguais ao arquivo inteiro\n");
+
+    const char *names[] = { "mmap inteiro", "read() 64 KiB" };
+    for (int mode = 0; mode < 2; mode++)
+    {
+        double best = 1e30;
+        for (int r = 0; r < repeats; r++)
+        {
+            count_t c = {0};
+            input_t src;
+            double t0 = now_s();
+            input_open(&src, path, mode == 0);
+            pattern_parser_init(&p, format, count_span, &c);
+            parse_input(&src, &p, NULL, NULL);
+            double t = now_s() - t0;
+            pattern_parser_free(&p);
+            input_close(&src);
+            if (c.cells != ref.cells)
+            {
+                printf("DIVERGIU: %s leu %llu células\n", names[mode], (unsigned long long)c.cells);
+                return 1;
+            }
+            if (t < best)
+                best = t;
+        }
+        printf("%-14s %8.1f MB/s  %9.1f M células/s  (%.3f s)\n", names[mode],
+               in.len / best / 1e6, ref.cells / best / 1e6, best);
+    }
+
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    printf("%s: %.1f MB, %llu células em %llu faixas, pico de memória %ld KiB%s\n",
+           format == PATTERN_MACROCELL ? "Macrocell" : "RLE", in.len / 1e6,
+           (unsigned long long)ref.cells, (unsigned long long)ref.spans, ru.ru_maxrss,
+           " (inclui as páginas do mmap)");
+    input_close(&in);
+    return 0;
+}
+
+// ---------- Gerador ----------
+
+// Macrocell com nós repetidos compartilhados, como o Golly grava
+typedef struct {
+    uint64_t key[2];
+    uint32_t index;
+} mc_entry_t;
+
+typedef struct {
+    FILE *out;
+    mc_entry_t *table;
+    size_t cap;
+    uint32_t count;
+} mc_writer_t;
+
+static uint32_t mc_intern(mc_writer_t *w, uint64_t k0, uint64_t k1, bool *fresh)
+{
+    uint64_t h = (k0 * 0x9E3779B97F4A7C15ull) ^ (k1 * 0xC2B2AE3D27D4EB4Full);
+    for (size_t i = h % w->cap;; i = (i + 1) % w->cap)
+    {
+        mc_entry_t *e = &w->table[i];
+        if (!e->index)
+        {
+            e->key[0] = k0;
+            e->key[1] = k1;
+            e->index = ++w->count;
+            *fresh = true;
+            return e->index;
+        }
+        if (e->key[0] == k0 && e->key[1] == k1)
+        {
+            *fresh = false;
+            return e->index;
+        }
+    }
+}
+
+static uint32_t mc_node(mc_writer_t *w, const life_grid_t *grid, int x, int y, int level)
+{
+    bool fresh;
+    if (level == 3)
+    {
+        uint64_t leaf = 0;
+        for (int r = 0; r < 8; r++)
+            for (int c = 0; c < 8; c++)
+                if (life_get(grid, x + c, y + r))
+                    leaf |= 1ull << (r * 8 + c);
+        if (!leaf)
+            return 0;
+        uint32_t index = mc_intern(w, leaf, 3, &fresh);
+        if (fresh)
+        {
+            for (int r = 0; r < 8; r++)
+            {
+                uint8_t row = (leaf >> (8 * r)) & 0xFF;
+                for (int c = 0; c < 8 && row >> c; c++)
+                    fputc((row >> c) & 1 ? '*' : '.', w->out);
+                fputc('$', w->out);
+            }
+            fputc('\n', w->out);
+        }
+        return index;
+    }
+
+    int half = 1 << (level - 1);
+    uint32_t c[4];
+    for (int q = 0; q < 4; q++)
+        c[q] = mc_node(w, grid, x + ((q & 1) ? half : 0), y + ((q & 2) ? half : 0), level - 1);
+    if (!c[0] && !c[1] && !c[2] && !c[3])
+        return 0;
+    uint32_t index = mc_intern(w, ((uint64_t)c[0] << 32) | c[1], ((uint64_t)c[2] << 32) | c[3] | ((uint64_t)level << 58), &fresh);
+    if (fresh)
+        fprintf(w->out, "%d %u %u %u %u\n", level, c[0], c[1], c[2], c[3]);
+    return index;
+}
+
+static int generate(int side, bool macrocell, const char *out_path)
+{
+    life_grid_t *grid = new_grid(side, side);
+    uint64_t state = 1;
+    for (int i = 0; i < LIFE_GRID_WORDS(side, side); i++)
+    {
+        // ~30% de densidade: AND de dois sorteios e um OR de um terceiro raro
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t a = state >> 32;
+        state = state * 6364136223846793005ull + 1442695040888963407ull;
+        uint32_t b = state >> 32;
+        grid->cells[i] = a & b;
+    }
+    for (int y = 0; y < side; y++)
+        for (int w = 0; w < grid->stride; w++)
+            if ((w + 1) * LIFE_WORD_BITS > side)
+                life_row(grid, y)[w] &= (1u << (side % LIFE_WORD_BITS)) - 1u;
+
+    FILE *f = out_path ? fopen(out_path, "w") : stdout;
+    if (!f)
+        return 1;
+    if (macrocell)
+    {
+        int level = 3;
+        while ((1 << level) < side)
+            level++;
+        mc_writer_t w = { .out = f, .cap = 1024 };
+        while (w.cap < (size_t)LIFE_GRID_WORDS(side, side) * 4)
+            w.cap *= 2;
+        w.table = calloc(w.cap, sizeof(mc_entry_t));
+        fprintf(f, "[M2] (patconv)\n#R B3/S23\n");
+        mc_node(&w, grid, 0, 0, level);
+        free(w.table);
+    }
+    else
+        pattern_write_rle(f, grid, LIFE_RULE_CONWAY, "sopa aleatória do patconv -G");
+    if (f != stdout)
+        fclose(f);
+    free_grid(grid);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    bool tiled = false, reverse = false, bench = false, macrocell = false, has_origin = false;
+    int tile_w = 0, tile_h = 0, repeats = 5, gen_side = 0;
+    int64_t x0 = 0, y0 = 0;
+    const char *out = NULL;
+    int opt;
+    while ((opt = getopt(argc, argv, "tW:H:x:y:o:rBn:G:M")) != -1)
+    {
+        switch (opt)
+        {
+        case 't': tiled = true; break;
+        case 'W': tile_w = atoi(optarg); break;
+        case 'H': tile_h = atoi(optarg); break;
+        case 'x': x0 = strtoll(optarg, NULL, 10); has_origin = true; break;
+        case 'y': y0 = strtoll(optarg, NULL, 10); has_origin = true; break;
+        case 'o': out = optarg; break;
+        case 'r': reverse = true; break;
+        case 'B': bench = true; break;
+        case 'n': repeats = atoi(optarg) > 0 ? atoi(optarg) : 1; break;
+        case 'G': gen_side = atoi(optarg); break;
+        case 'M': macrocell = true; break;
+        default:
+            goto usage;
+        }
+    }
+    if (gen_side > 0)
+        return generate(gen_side, macrocell, out);
+    if (optind >= argc)
+        goto usage;
+    if (reverse)
+        return export_rle(argv[optind], out);
+    if (bench)
+        return benchmark(argv[optind], repeats);
+
+    if (!tile_w)
+        tile_w = tiled ? DIST_TILE_WIDTH : LIFE_GRID_WIDTH;
+    if (!tile_h)
+        tile_h = tiled ? DIST_TILE_HEIGHT : LIFE_GRID_HEIGHT;
+    if (tile_w < 1 || tile_h < 1 || tile_w > 65535 || tile_h > 65535)
+        goto usage;
+    sink_t sink = {
+        .tile_w = tile_w, .tile_h = tile_h, .x0 = x0, .y0 = y0, .band = -1,
+        .out = tiled && !out ? "tile" : out, .tiled = tiled, .has_origin = has_origin,
+    };
+    return import_pattern(argv[optind], &sink);
+
+usage:
+    fprintf(stderr,
+            "uso: %s [-t] [-W largura] [-H altura] [-x x0] [-y y0] [-o saída] padrão\n"
+            "     %s -r [-o saída.rle] captura\n"
+            "     %s -B [-n repetições] padrão\n"
+            "     %s -G lado [-M] [-o saída]\n",
+            argv[0], argv[0], argv[0], argv[0]);
+    return 2;
+}
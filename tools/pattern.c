@@ -0,0 +1,563 @@
+#include "pattern.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_COUNT 1000000000000ll // runs maiores que isso são erro de arquivo
+#define MAX_LEVEL 62              // coordenadas cabem em int64_t
+#define RLE_LINE 70
+
+enum {
+    ST_LINE_START,
+    ST_COMMENT,
+    ST_HEADER,
+    ST_SKIP_LINE,
+    ST_BODY,
+    ST_MC_LEAF,
+    ST_MC_NODE,
+};
+
+// ---------- Helpers ----------
+
+static bool fail(pattern_parser_t *p, const char *msg)
+{
+    if (!p->failed)
+        snprintf(p->error, sizeof(p->error), "%s (byte %llu)", msg, (unsigned long long)p->bytes);
+    p->failed = true;
+    return false;
+}
+
+static void clip_span(pattern_parser_t *p, int64_t x, int64_t y, int64_t len)
+{
+    if (y < p->win_y0 || y >= p->win_y1)
+        return;
+    int64_t a = x > p->win_x0 ? x : p->win_x0;
+    int64_t b = x + len < p->win_x1 ? x + len : p->win_x1;
+    if (a < b)
+        p->span(p->ctx, a, y, b - a);
+}
+
+static void flush_run(pattern_parser_t *p)
+{
+    if (p->run_len)
+        clip_span(p, p->run_x, p->run_y, p->run_len);
+    p->run_len = 0;
+}
+
+// Junta runs vizinhas da mesma linha ("2o3o", multiestado "AB") numa faixa só
+static void add_run(pattern_parser_t *p, int64_t x, int64_t y, int64_t len)
+{
+    p->cells += len;
+    if (p->run_len && p->run_y == y && p->run_x + p->run_len == x)
+    {
+        p->run_len += len;
+        return;
+    }
+    flush_run(p);
+    p->run_x = x;
+    p->run_y = y;
+    p->run_len = len;
+}
+
+static void append_line(pattern_parser_t *p, char c)
+{
+    if (p->line_len < (int)sizeof(p->line) - 1)
+        p->line[p->line_len++] = c;
+}
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// ---------- Cabeçalho RLE ----------
+
+// "x = 3, y = 3, rule = B3/S23"
+static void parse_header(pattern_parser_t *p)
+{
+    p->line[p->line_len] = '\0';
+    for (char *part = strtok(p->line, ","); part; part = strtok(NULL, ","))
+    {
+        char *eq = strchr(part, '=');
+        if (!eq)
+            continue;
+        *eq = '\0';
+        char *key = part, *value = eq + 1;
+        while (is_space(*key)) key++;
+        while (is_space(*value)) value++;
+        if (key[0] == 'x' && (key[1] == '\0' || is_space(key[1])))
+            p->width = strtoll(value, NULL, 10);
+        else if (key[0] == 'y' && (key[1] == '\0' || is_space(key[1])))
+            p->height = strtoll(value, NULL, 10);
+        else if (strncmp(key, "rule", 4) == 0)
+            p->has_rule = life_parse_rule(value, &p->rule);
+    }
+    p->has_size = p->width > 0 && p->height > 0;
+    p->header_seen = true;
+}
+
+static void parse_comment(pattern_parser_t *p)
+{
+    p->line[p->line_len] = '\0';
+    // "#R B3/S23" do Macrocell
+    if (p->line[0] == 'R' && !p->has_rule)
+        p->has_rule = life_parse_rule(p->line + 1, &p->rule);
+}
+
+// ---------- Corpo RLE ----------
+
+static bool rle_body(pattern_parser_t *p, char c)
+{
+    if (c >= '0' && c <= '9')
+    {
+        p->count = p->count * 10 + (c - '0');
+        return p->count <= MAX_COUNT || fail(p, "contagem grande demais");
+    }
+
+    if (c == '\n')
+    {
+        p->state = ST_LINE_START; // a contagem pode continuar na próxima linha
+        return true;
+    }
+    if (is_space(c))
+        return true;
+    if (c >= 'p' && c <= 'y' && !p->prefix)
+    {
+        // "pA".."yX": estados acima de 24, todos vivos para o Life
+        p->prefix = true;
+        return true;
+    }
+
+    int64_t n = p->count ? p->count : 1;
+    p->count = 0;
+
+    if (p->prefix)
+    {
+        p->prefix = false;
+        if (c < 'A' || c > 'X')
+            return fail(p, "estado multiestado inválido");
+        add_run(p, p->x, p->y, n);
+        p->x += n;
+        return true;
+    }
+
+    switch (c)
+    {
+    case 'b':
+    case '.':
+        p->x += n;
+        return true;
+    case 'o':
+        add_run(p, p->x, p->y, n);
+        p->x += n;
+        return true;
+    case '$':
+        p->y += n;
+        p->x = 0;
+        if (p->y >= p->win_y1)
+        {
+            // Já passou da janela: o resto do arquivo não interessa
+            flush_run(p);
+            p->done = true;
+        }
+        return true;
+    case '!':
+        flush_run(p);
+        p->done = true;
+        return true;
+    default:
+        if (c >= 'A' && c <= 'X')
+        {
+            add_run(p, p->x, p->y, n);
+            p->x += n;
+            return true;
+        }
+        return fail(p, "caractere inválido no RLE");
+    }
+}
+
+// ---------- Macrocell ----------
+
+static bool add_node(pattern_parser_t *p, pattern_node_t *node)
+{
+    if (p->node_count + 1 >= p->node_cap)
+    {
+        uint32_t cap = p->node_cap ? p->node_cap * 2 : 1024;
+        pattern_node_t *nodes = realloc(p->nodes, cap * sizeof(pattern_node_t));
+        if (!nodes)
+            return fail(p, "sem memória para os nós");
+        p->nodes = nodes;
+        p->node_cap = cap;
+    }
+    p->nodes[++p->node_count] = *node;
+    return true;
+}
+
+static bool finish_leaf(pattern_parser_t *p)
+{
+    pattern_node_t node = { .level = 3, .leaf = p->num[0] };
+    int minx = 8, maxx = -1, miny = 8, maxy = -1;
+    for (int y = 0; y < 8; y++)
+    {
+        uint8_t row = (node.leaf >> (8 * y)) & 0xFF;
+        if (!row)
+            continue;
+        if (y < miny) miny = y;
+        maxy = y;
+        if (__builtin_ctz(row) < minx) minx = __builtin_ctz(row);
+        if (31 - __builtin_clz(row) > maxx) maxx = 31 - __builtin_clz(row);
+    }
+    if (maxy >= 0)
+        node.box = (pattern_box_t){ minx, miny, maxx - minx + 1, maxy - miny + 1 };
+    return add_node(p, &node);
+}
+
+static bool finish_node(pattern_parser_t *p)
+{
+    if (p->in_num)
+        p->num_index++;
+    p->in_num = false;
+    if (p->num_index != 5)
+        return fail(p, "nó do Macrocell precisa de 5 números");
+
+    int level = (int)p->num[0];
+    if (level < 4)
+        return fail(p, "Macrocell multiestado não suportado");
+    if (level > MAX_LEVEL)
+        return fail(p, "Macrocell grande demais");
+
+    pattern_node_t node = { .level = level };
+    const int64_t half = (int64_t)1 << (level - 1);
+    int64_t x0 = INT64_MAX, y0 = INT64_MAX, x1 = INT64_MIN, y1 = INT64_MIN;
+    for (int q = 0; q < 4; q++)
+    {
+        uint64_t c = p->num[1 + q];
+        if (c > p->node_count || (c && p->nodes[c].level != level - 1))
+            return fail(p, "filho inválido no Macrocell");
+        node.child[q] = (uint32_t)c;
+        if (!c || !p->nodes[c].box.width)
+            continue;
+        const pattern_box_t *b = &p->nodes[c].box;
+        int64_t ox = (q & 1) ? half : 0, oy = (q & 2) ? half : 0;
+        if (ox + b->x < x0) x0 = ox + b->x;
+        if (oy + b->y < y0) y0 = oy + b->y;
+        if (ox + b->x + b->width > x1) x1 = ox + b->x + b->width;
+        if (oy + b->y + b->height > y1) y1 = oy + b->y + b->height;
+    }
+    if (x1 > x0)
+        node.box = (pattern_box_t){ x0, y0, x1 - x0, y1 - y0 };
+    return add_node(p, &node);
+}
+
+static bool mc_char(pattern_parser_t *p, char c)
+{
+    if (p->state == ST_MC_LEAF)
+    {
+        switch (c)
+        {
+        case '.':
+            p->leaf_x++;
+            return true;
+        case '*':
+            if (p->leaf_x >= 8 || p->leaf_y >= 8)
+                return fail(p, "folha do Macrocell maior que 8x8");
+            p->num[0] |= 1ull << (p->leaf_y * 8 + p->leaf_x++);
+            return true;
+        case '$':
+            p->leaf_y++;
+            p->leaf_x = 0;
+            return true;
+        case '\n':
+            p->state = ST_LINE_START;
+            return finish_leaf(p);
+        default:
+            return is_space(c) || fail(p, "caractere inválido na folha");
+        }
+    }
+
+    // ST_MC_NODE: "nível nw ne sw se"
+    if (c >= '0' && c <= '9')
+    {
+        if (p->num_index >= 5)
+            return fail(p, "números demais no nó");
+        p->num[p->num_index] = p->num[p->num_index] * 10 + (c - '0');
+        p->in_num = true;
+        return p->num[p->num_index] < UINT32_MAX || fail(p, "número grande demais");
+    }
+    if (c == '\n')
+    {
+        p->state = ST_LINE_START;
+        return finish_node(p);
+    }
+    if (!is_space(c))
+        return fail(p, "caractere inválido no nó");
+    if (p->in_num)
+        p->num_index++;
+    p->in_num = false;
+    return true;
+}
+
+static void expand_node(pattern_parser_t *p, uint32_t index, int64_t ox, int64_t oy)
+{
+    const pattern_node_t *node = &p->nodes[index];
+    const pattern_box_t *b = &node->box;
+    if (!b->width || ox + b->x >= p->win_x1 || oy + b->y >= p->win_y1 ||
+        ox + b->x + b->width <= p->win_x0 || oy + b->y + b->height <= p->win_y0)
+        return;
+
+    if (node->level == 3)
+    {
+        for (int y = 0; y < 8; y++)
+        {
+            uint32_t row = (node->leaf >> (8 * y)) & 0xFF;
+            while (row)
+            {
+                int start = __builtin_ctz(row);
+                int len = __builtin_ctz(~(row >> start));
+                p->cells += len;
+                clip_span(p, ox + start, oy + y, len);
+                row &= ~(((1u << len) - 1u) << start);
+            }
+        }
+        return;
+    }
+
+    const int64_t half = (int64_t)1 << (node->level - 1);
+    for (int q = 0; q < 4; q++)
+        if (node->child[q])
+            expand_node(p, node->child[q], ox + ((q & 1) ? half : 0), oy + ((q & 2) ? half : 0));
+}
+
+// ---------- API ----------
+
+pattern_format_t pattern_detect(const char *path, const char *head, size_t len)
+{
+    if (len >= 2 && head[0] == '[' && head[1] == 'M')
+        return PATTERN_MACROCELL;
+    size_t n = path ? strlen(path) : 0;
+    if (n >= 3 && strcmp(path + n - 3, ".mc") == 0)
+        return PATTERN_MACROCELL;
+    return PATTERN_RLE;
+}
+
+void pattern_parser_init(pattern_parser_t *p, pattern_format_t format, pattern_span_fn span,
+                         void *ctx)
+{
+    memset(p, 0, sizeof(*p));
+    p->format = format;
+    p->span = span;
+    p->ctx = ctx;
+    p->rule = LIFE_RULE_CONWAY;
+    p->state = ST_LINE_START;
+    pattern_set_window(p, INT64_MIN / 4, INT64_MIN / 4, INT64_MAX / 2, INT64_MAX / 2);
+}
+
+void pattern_parser_free(pattern_parser_t *p)
+{
+    free(p->nodes);
+    p->nodes = NULL;
+    p->node_count = p->node_cap = 0;
+}
+
+void pattern_set_window(pattern_parser_t *p, int64_t x0, int64_t y0, int64_t w, int64_t h)
+{
+    p->win_x0 = x0;
+    p->win_y0 = y0;
+    p->win_x1 = x0 + w;
+    p->win_y1 = y0 + h;
+}
+
+bool pattern_feed(pattern_parser_t *p, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len && !p->done; i++, p->bytes++)
+    {
+        char c = data[i];
+        switch (p->state)
+        {
+        case ST_LINE_START:
+            if (c == '#')
+            {
+                p->line_len = 0;
+                p->state = ST_COMMENT;
+            }
+            else if (c == '\n' || is_space(c))
+                ;
+            else if (p->format == PATTERN_MACROCELL)
+            {
+                if (c == '[')
+                    p->state = ST_SKIP_LINE;
+                else if (c == '.' || c == '*' || c == '$')
+                {
+                    p->state = ST_MC_LEAF;
+                    p->num[0] = 0;
+                    p->leaf_x = p->leaf_y = 0;
+                    if (!mc_char(p, c))
+                        return false;
+                }
+                else if (c >= '0' && c <= '9')
+                {
+                    p->state = ST_MC_NODE;
+                    memset(p->num, 0, sizeof(p->num));
+                    p->num_index = 0;
+                    p->in_num = false;
+                    if (!mc_char(p, c))
+                        return false;
+                }
+                else
+                    return fail(p, "linha inválida no Macrocell");
+            }
+            else if (c == 'x' && !p->header_seen)
+            {
+                p->line_len = 0;
+                append_line(p, c);
+                p->state = ST_HEADER;
+            }
+            else
+            {
+                p->state = ST_BODY;
+                if (!rle_body(p, c))
+                    return false;
+            }
+            break;
+
+        case ST_COMMENT:
+        case ST_HEADER:
+            if (c == '\n')
+            {
+                if (p->state == ST_HEADER)
+                    parse_header(p);
+                else
+                    parse_comment(p);
+                p->state = ST_LINE_START;
+            }
+            else
+                append_line(p, c);
+            break;
+
+        case ST_SKIP_LINE:
+            if (c == '\n')
+                p->state = ST_LINE_START;
+            break;
+
+        case ST_BODY:
+            if (!rle_body(p, c))
+                return false;
+            break;
+
+        default:
+            if (!mc_char(p, c))
+                return false;
+            break;
+        }
+    }
+    return !p->failed;
+}
+
+bool pattern_finish(pattern_parser_t *p)
+{
+    // Última linha sem '\n'
+    if (!p->done && p->state != ST_LINE_START && p->state != ST_BODY && !pattern_feed(p, "\n", 1))
+        return false;
+    flush_run(p);
+    if (p->format == PATTERN_MACROCELL)
+    {
+        if (!p->node_count)
+            return fail(p, "Macrocell sem nós");
+        pattern_expand(p);
+    }
+    return !p->failed;
+}
+
+pattern_box_t pattern_bounds(const pattern_parser_t *p)
+{
+    if (p->format == PATTERN_MACROCELL)
+        return p->node_count ? p->nodes[p->node_count].box : (pattern_box_t){ 0, 0, 0, 0 };
+    if (p->has_size)
+        return (pattern_box_t){ 0, 0, p->width, p->height };
+    return (pattern_box_t){ 0, 0, 0, 0 };
+}
+
+void pattern_expand(pattern_parser_t *p)
+{
+    // A raiz é o último nó; coordenadas a partir do canto dela
+    if (p->node_count)
+        expand_node(p, p->node_count, 0, 0);
+}
+
+// ---------- Escrita RLE ----------
+
+static void rle_token(pattern_rle_writer_t *w, int64_t n, char c)
+{
+    char buf[32];
+    int len = n > 1 ? snprintf(buf, sizeof(buf), "%lld%c", (long long)n, c)
+                    : snprintf(buf, sizeof(buf), "%c", c);
+    if (w->line_len + len > RLE_LINE)
+    {
+        fputc('\n', w->out);
+        w->line_len = 0;
+    }
+    fputs(buf, w->out);
+    w->line_len += len;
+}
+
+// Primeira coluna a partir de x com valor diferente de bit (ou width)
+static int next_change(const uint32_t *row, int x, int width, bool bit)
+{
+    const int words = LIFE_STRIDE(width);
+    int w = x / LIFE_WORD_BITS;
+    uint32_t v = (bit ? ~row[w] : row[w]) & (0xFFFFFFFFu << (x % LIFE_WORD_BITS));
+    while (!v && ++w < words)
+        v = bit ? ~row[w] : row[w];
+    if (w >= words)
+        return width;
+    int found = w * LIFE_WORD_BITS + __builtin_ctz(v);
+    return found < width ? found : width;
+}
+
+void pattern_rle_begin(pattern_rle_writer_t *w, FILE *out, int width, int height,
+                       life_rule_t rule, const char *comment)
+{
+    char text[LIFE_RULE_TEXT_MAX];
+    life_format_rule(rule, text, sizeof(text));
+    memset(w, 0, sizeof(*w));
+    w->out = out;
+    w->width = width;
+    if (comment)
+        fprintf(out, "#C %s\n", comment);
+    fprintf(out, "x = %d, y = %d, rule = %s\n", width, height, text);
+}
+
+void pattern_rle_row(pattern_rle_writer_t *w, const uint32_t *row)
+{
+    int x = 0;
+    while (x < w->width)
+    {
+        int start = next_change(row, x, w->width, false);
+        if (start >= w->width)
+            break;
+        int end = next_change(row, start, w->width, true);
+
+        if (w->blank_rows)
+            rle_token(w, w->blank_rows, '$');
+        w->blank_rows = 0;
+        if (start > x)
+            rle_token(w, start - x, 'b');
+        rle_token(w, end - start, 'o');
+        x = end;
+    }
+    w->blank_rows++;
+}
+
+void pattern_rle_end(pattern_rle_writer_t *w)
+{
+    rle_token(w, 1, '!');
+    fputc('\n', w->out);
+}
+
+void pattern_write_rle(FILE *out, const life_grid_t *grid, life_rule_t rule, const char *comment)
+{
+    pattern_rle_writer_t w;
+    pattern_rle_begin(&w, out, grid->width, grid->height, rule, comment);
+    for (int y = 0; y < grid->height; y++)
+        pattern_rle_row(&w, life_row(grid, y));
+    pattern_rle_end(&w);
+}
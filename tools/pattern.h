@@ -0,0 +1,115 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "life.h"
+
+// Leitura e escrita de padrões do Golly (RLE e Macrocell) no host.
+//
+// O parser é incremental: recebe o arquivo em pedaços de qualquer tamanho
+// (pattern_feed) e entrega as células vivas como faixas horizontais, sem
+// guardar o padrão. No RLE a memória é fixa; no Macrocell os nós da árvore
+// ficam guardados (o arquivo é uma árvore comprimida, só dá para expandir no
+// fim), mas nunca o padrão expandido.
+
+// ---------------- Leitura ----------------
+typedef enum {
+    PATTERN_RLE,
+    PATTERN_MACROCELL,
+} pattern_format_t;
+
+// Células vivas [x, x + len) da linha y, já recortadas pela janela
+typedef void (*pattern_span_fn)(void *ctx, int64_t x, int64_t y, int64_t len);
+
+typedef struct {
+    int64_t x, y;          // canto de cima à esquerda
+    int64_t width, height; // 0 x 0 = vazio
+} pattern_box_t;
+
+typedef struct {
+    uint32_t child[4]; // nw, ne, sw, se; 0 = vazio (nível > 3)
+    uint64_t leaf;     // 8x8, bit y * 8 + x (nível 3)
+    pattern_box_t box; // células vivas, relativo ao canto do nó
+    uint8_t level;
+} pattern_node_t;
+
+typedef struct {
+    pattern_format_t format;
+    pattern_span_fn span;
+    void *ctx;
+
+    // Janela de recorte; fora dela nada é entregue
+    int64_t win_x0, win_y0, win_x1, win_y1;
+
+    // Cabeçalho
+    bool has_size;
+    int64_t width, height; // "x = ..., y = ..." do RLE
+    bool has_rule;
+    life_rule_t rule;
+
+    // Estado da máquina
+    int state;
+    bool header_seen;
+    bool done;
+    bool failed;
+    char error[64];
+    char line[256]; // linha de cabeçalho/comentário em andamento
+    int line_len;
+    uint64_t bytes;
+    uint64_t cells;
+
+    // RLE
+    int64_t x, y, count;
+    bool prefix; // estado multiestado "pA".."yX" em andamento
+    int64_t run_x, run_y, run_len; // faixa pendente, para juntar runs vizinhas
+
+    // Macrocell
+    pattern_node_t *nodes; // nodes[0] não é usado
+    uint32_t node_count, node_cap;
+    uint64_t num[5];
+    int num_index;
+    bool in_num;
+    int leaf_x, leaf_y;
+} pattern_parser_t;
+
+// Formato pela extensão ou pelo começo do conteúdo
+pattern_format_t pattern_detect(const char *path, const char *head, size_t len);
+
+void pattern_parser_init(pattern_parser_t *p, pattern_format_t format, pattern_span_fn span,
+                         void *ctx);
+void pattern_parser_free(pattern_parser_t *p);
+// Só entrega células dentro de [x0, x0 + w) x [y0, y0 + h)
+void pattern_set_window(pattern_parser_t *p, int64_t x0, int64_t y0, int64_t w, int64_t h);
+
+// false em erro (p->error); p->done fica true no '!' do RLE ou quando o RLE
+// já passou do fim da janela, e aí o resto do arquivo pode ser ignorado
+bool pattern_feed(pattern_parser_t *p, const char *data, size_t len);
+// Fecha o arquivo; no Macrocell é aqui que a árvore vira faixas
+bool pattern_finish(pattern_parser_t *p);
+
+// Caixa das células vivas: do cabeçalho no RLE, da árvore no Macrocell
+// (depois de pattern_finish)
+pattern_box_t pattern_bounds(const pattern_parser_t *p);
+// Macrocell: entrega de novo as faixas de uma outra janela, sem reler o arquivo
+void pattern_expand(pattern_parser_t *p);
+
+// ---------------- Escrita ----------------
+typedef struct {
+    FILE *out;
+    int width;
+    int line_len;        // para quebrar em 70 colunas como o Golly
+    int64_t blank_rows;  // '$' pendentes
+    bool row_started;
+} pattern_rle_writer_t;
+
+void pattern_rle_begin(pattern_rle_writer_t *w, FILE *out, int width, int height,
+                       life_rule_t rule, const char *comment);
+// Uma linha empacotada como no life_grid_t (bit x da palavra x / 32)
+void pattern_rle_row(pattern_rle_writer_t *w, const uint32_t *row);
+void pattern_rle_end(pattern_rle_writer_t *w);
+
+void pattern_write_rle(FILE *out, const life_grid_t *grid, life_rule_t rule, const char *comment);
+
+#endif // PATTERN_H
@@ -0,0 +1,231 @@
+// Replay de um trace de entradas (TRACE_MODE no firmware) no host, rodando o
+// mesmo src/game.c e medindo cada quadro (update_life + render_life).
+//
+//   replay [-c] [-f] [-n repetições] trace
+//
+// O trace pode ser o binário tirado da flash (picotool save) ou o log do
+// stdio USB com as linhas "TRACE <hex>". Com -n o replay roda várias vezes e
+// cada quadro fica com o menor tempo, para tirar ruído antes de um bisect.
+// -c imprime o CSV por quadro: quadro,tempo_ms,passo,us.
+// Um trace com eventos perdidos na gravação (TRACE_DROPPED) não reproduz a
+// sessão: o replay recusa, a não ser com -f. Um trace que encheu a flash
+// termina em TRACE_TRUNCATED, e o replay só avisa.
+
+#include "game.h"
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static uint8_t *load_trace(const char *path, size_t *out_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    uint8_t *raw = malloc(size + 1);
+    if (fread(raw, 1, size, f) != (size_t)size)
+    {
+        fclose(f);
+        free(raw);
+        return NULL;
+    }
+    fclose(f);
+    raw[size] = '\0';
+
+    if (size >= 4 && memcmp(raw, TRACE_MAGIC, 4) == 0)
+    {
+        *out_len = size;
+        return raw;
+    }
+
+    // Log do USB: junta o hex das linhas "TRACE ", ignora o resto
+    uint8_t *bin = malloc(size / 2 + 1);
+    size_t len = 0;
+    for (char *line = strtok((char *)raw, "\r\n"); line; line = strtok(NULL, "\r\n"))
+    {
+        char *hex = strstr(line, "TRACE ");
+        if (!hex)
+            continue;
+        for (hex += 6; hex[0] && hex[1]; hex += 2)
+        {
+            unsigned byte;
+            if (sscanf(hex, "%2x", &byte) != 1)
+                break;
+            bin[len++] = byte;
+        }
+    }
+    free(raw);
+    *out_len = len;
+    return bin;
+}
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+typedef struct {
+    uint32_t time_ms;
+    bool stepped;
+    uint64_t ns;
+} frame_t;
+
+// Uma passada pelo trace; devolve o número de quadros
+static size_t run(const uint8_t *data, size_t len, frame_t *frames, size_t max_frames, bool first)
+{
+    static uint8_t buf[ssd1306_buffer_length];
+    trace_reader_t reader;
+    trace_reader_init(&reader, data, len);
+    game_init();
+
+    size_t n = 0;
+    trace_event_t ev;
+    while (trace_next(&reader, &ev) && n < max_frames)
+    {
+        switch (ev.type)
+        {
+        case TRACE_BTN_A:
+            game_press_a();
+            break;
+        case TRACE_BTN_B:
+            game_press_b();
+            break;
+        case TRACE_MOVE:
+            game_move_cursor(ev.dx, ev.dy);
+            break;
+        case TRACE_MQTT_BEGIN:
+            game_ingest_begin(ev.total_length);
+            break;
+        case TRACE_MQTT:
+            game_ingest(ev.data, ev.len, ev.last);
+            break;
+        case TRACE_FRAME:
+        {
+            uint64_t start = now_ns();
+            if (ev.stepped)
+                update_life();
+            render_life(buf, &life_grid, 0, 0, ev.time_ms);
+            uint64_t ns = now_ns() - start;
+
+            if (first || ns < frames[n].ns)
+                frames[n].ns = ns;
+            frames[n].time_ms = ev.time_ms;
+            frames[n].stepped = ev.stepped;
+            n++;
+            break;
+        }
+        }
+    }
+    return n;
+}
+
+int main(int argc, char **argv)
+{
+    bool csv = false;
+    int repeats = 1;
+    int opt;
+    bool force = false;
+    while ((opt = getopt(argc, argv, "cfn:")) != -1)
+    {
+        switch (opt)
+        {
+        case 'c': csv = true; break;
+        case 'f': force = true; break;
+        case 'n': repeats = atoi(optarg) > 0 ? atoi(optarg) : 1; break;
+        default:
+            fprintf(stderr, "uso: %s [-c] [-f] [-n repetições] trace\n", argv[0]);
+            return 2;
+        }
+    }
+    if (optind >= argc)
+    {
+        fprintf(stderr, "uso: %s [-c] [-f] [-n repetições] trace\n", argv[0]);
+        return 2;
+    }
+
+    size_t len;
+    uint8_t *data = load_trace(argv[optind], &len);
+    trace_reader_t check;
+    if (!data || !trace_reader_init(&check, data, len))
+    {
+        fprintf(stderr, "%s: trace inválido\n", argv[optind]);
+        return 1;
+    }
+
+    // Buracos da gravação: depois do primeiro, o replay é outra sessão
+    trace_event_t ev;
+    unsigned long gaps = 0, lost = 0, first_ms = 0;
+    while (trace_next(&check, &ev))
+    {
+        if (ev.type == TRACE_DROPPED)
+        {
+            if (!gaps++)
+                first_ms = ev.time_ms;
+            lost += ev.count;
+        }
+        else if (ev.type == TRACE_TRUNCATED)
+            fprintf(stderr, "%s: a gravação parou em t=%lu ms com a flash cheia\n", argv[optind],
+                    (unsigned long)ev.time_ms);
+    }
+    if (gaps)
+    {
+        fprintf(stderr, "%s: %lu eventos perdidos na gravação (%lu buraco%s, o primeiro antes de t=%lu ms)%s\n",
+                argv[optind], lost, gaps, gaps > 1 ? "s" : "", first_ms,
+                force ? "; o replay diverge da sessão dali em diante" : "; -f para rodar assim mesmo");
+        if (!force)
+            return 1;
+    }
+
+    // Cada quadro ocupa pelo menos 3 bytes no trace
+    size_t max_frames = len / 3 + 1;
+    frame_t *frames = calloc(max_frames, sizeof(frame_t));
+    size_t n = 0;
+    for (int r = 0; r < repeats; r++)
+        n = run(data, len, frames, max_frames, r == 0);
+
+    if (csv)
+    {
+        printf("quadro,tempo_ms,passo,us\n");
+        for (size_t i = 0; i < n; i++)
+            printf("%zu,%lu,%d,%.2f\n", i, (unsigned long)frames[i].time_ms, frames[i].stepped,
+                   frames[i].ns / 1000.0);
+    }
+
+    // ---- Resumo ----
+    uint64_t *sorted = malloc((n ? n : 1) * sizeof(uint64_t));
+    uint64_t total = 0;
+    size_t steps = 0, worst = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        sorted[i] = frames[i].ns;
+        total += frames[i].ns;
+        steps += frames[i].stepped;
+        if (frames[i].ns > frames[worst].ns)
+            worst = i;
+    }
+    qsort(sorted, n, sizeof(uint64_t), cmp_u64);
+
+    fprintf(csv ? stderr : stdout,
+            "%zu quadros (%zu passos), média %.2f us, p50 %.2f us, p99 %.2f us, "
+            "pior %.2f us no quadro %zu (t=%lu ms)\n"
+            "geração %lu, checksum %08lx, padrões: %lu aplicados, %lu descartados\n",
+            n, steps, n ? total / 1000.0 / n : 0.0, n ? sorted[n / 2] / 1000.0 : 0.0,
+            n ? sorted[n * 99 / 100] / 1000.0 : 0.0, n ? frames[worst].ns / 1000.0 : 0.0, worst,
+            n ? (unsigned long)frames[worst].time_ms : 0ul, (unsigned long)life_generation,
+            (unsigned long)life_checksum(&life_grid), (unsigned long)life_ingest.stats.messages,
+            (unsigned long)life_ingest.stats.dropped);
+    return 0;
+}
@@ -0,0 +1,1005 @@
+// Censo de sopas aleatórias no host, com o kernel do firmware (life_step_batch).
+// Cada thread roda BATCH universos de 32x32 ao mesmo tempo, um por pista do
+// lote; quando um estabiliza (estado repete com período até PERIOD_MAX) ele é
+// classificado e a pista recebe a próxima sopa. As sopas são distribuídas em
+// tarefas por filas com roubo de trabalho entre as threads.
+//
+//   soup_search [-n sopas] [-j threads] [-g gerações] [-s semente]
+//               [-z lado] [-k melhores] [-o pasta] [-S]
+//
+// As sopas mais interessantes saem no formato do tópico pico/life
+// ("[[x,y],...]", como o frontend manda); com -o cada uma vira um arquivo
+// soup-<número>.json. Só entram sopas que nunca encostaram na borda do
+// universo: aí a evolução é a mesma no tabuleiro maior do Pico.
+// -S mede sopas/s com 1, 2, 4... threads até o número de núcleos e confere
+// que o censo é o mesmo em todas as rodadas.
+// Objetos sem nome comum saem com o apgcode (xs<população>_..., xp<período>_...,
+// Wechsler estendido da fase e orientação canônicas), o mesmo do Catagolue.
+
+#include "game.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define UNIVERSE 32   // lado do universo: uma palavra por linha
+#define BATCH 64      // universos por lote
+#define PERIOD_MAX 16 // pega até o pentadecathlon (p15)
+#define TASK_SOUPS 256
+#define EDGE_MASK 0x80000001u
+
+#define MAX_THREADS 256
+#define TOP_MAX 64
+#define CENSUS_SIZE 4096
+#define NAME_MAX_LEN 256 // apgcode de um objeto de até 32x32
+#define KEY_MAX 320
+#define OBJECTS_MAX 64
+
+static life_rule_t rule = LIFE_RULE_CONWAY;
+static uint64_t total_soups = 200000;
+static uint64_t seed = 1;
+static int max_gens = 4000;
+static int top_k = 10;
+static int soup_size = 16; // sopa aleatória no centro do universo
+#define SOUP_OFFSET ((UNIVERSE - soup_size) / 2)
+
+// ---------- Sopas ----------
+
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Sopa número index: soup_size x soup_size células aleatórias no centro
+static void make_soup(uint64_t index, uint32_t rows[UNIVERSE])
+{
+    uint64_t state = seed ^ (index * 0xD1342543DE82EF95ull);
+    const uint32_t mask = soup_size >= 32 ? 0xFFFFFFFFu : (1u << soup_size) - 1u;
+    memset(rows, 0, UNIVERSE * sizeof(uint32_t));
+    for (int y = 0; y < soup_size; y++)
+        rows[SOUP_OFFSET + y] = ((uint32_t)splitmix64(&state) & mask) << SOUP_OFFSET;
+}
+
+static uint64_t hash_rows(const uint32_t *rows, int step)
+{
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (int y = 0; y < UNIVERSE; y++)
+        h = (h ^ rows[y * step]) * 0x100000001B3ull;
+    return h;
+}
+
+// ---------- Objetos ----------
+
+// Forma canônica: menor string "LxA:linhas" entre as 8 simetrias e as fases
+static void shape_key(const uint32_t rows[UNIVERSE], char *key)
+{
+    int minx = UNIVERSE, maxx = -1, miny = UNIVERSE, maxy = -1;
+    for (int y = 0; y < UNIVERSE; y++)
+        if (rows[y])
+        {
+            if (y < miny) miny = y;
+            maxy = y;
+            int lo = __builtin_ctz(rows[y]), hi = 31 - __builtin_clz(rows[y]);
+            if (lo < minx) minx = lo;
+            if (hi > maxx) maxx = hi;
+        }
+    key[0] = '\0';
+    if (maxy < 0)
+        return;
+
+    int w = maxx - minx + 1, h = maxy - miny + 1;
+    for (int t = 0; t < 8; t++)
+    {
+        bool swap = t & 4;
+        int tw = swap ? h : w, th = swap ? w : h;
+        char buf[KEY_MAX];
+        int len = snprintf(buf, sizeof(buf), "%dx%d:", tw, th);
+        for (int ty = 0; ty < th; ty++)
+        {
+            uint32_t line = 0;
+            for (int tx = 0; tx < tw; tx++)
+            {
+                int x = swap ? ty : tx, y = swap ? tx : ty;
+                if (t & 1) x = w - 1 - x;
+                if (t & 2) y = h - 1 - y;
+                if ((rows[miny + y] >> (minx + x)) & 1u)
+                    line |= 1u << tx;
+            }
+            len += snprintf(buf + len, sizeof(buf) - len, "%x.", line);
+        }
+        if (!key[0] || strcmp(buf, key) < 0)
+            strcpy(key, buf);
+    }
+}
+
+static uint32_t fnv32(const char *s)
+{
+    uint32_t h = 2166136261u;
+    while (*s)
+        h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+// ---------- apgcode ----------
+
+// Wechsler estendido de uma orientação (t como em shape_key): faixas de 5
+// linhas separadas por 'z', um caractere por coluna com o bit 0 na linha de
+// cima, corridas de colunas vazias como 0, w, x ou y<n> (4 + n) e sem as
+// colunas vazias do fim da faixa
+static void wechsler(const uint32_t rows[UNIVERSE], int minx, int miny, int w, int h, int t,
+                     char *out)
+{
+    static const char digits[] = "0123456789abcdefghijklmnopqrstuvwxyz";
+    bool swap = t & 4;
+    int length = swap ? h : w, breadth = swap ? w : h;
+    int len = 0;
+    for (int v = 0; v * 5 < breadth; v++)
+    {
+        if (v)
+            out[len++] = 'z';
+        int zeros = 0;
+        for (int u = 0; u < length; u++)
+        {
+            int column = 0;
+            for (int k = 0; k < 5 && v * 5 + k < breadth; k++)
+            {
+                int x = swap ? v * 5 + k : u, y = swap ? u : v * 5 + k;
+                if (t & 1) x = w - 1 - x;
+                if (t & 2) y = h - 1 - y;
+                column |= ((rows[miny + y] >> (minx + x)) & 1u) << k;
+            }
+            if (!column)
+            {
+                zeros++;
+                continue;
+            }
+            if (zeros == 1)
+                out[len++] = '0';
+            else if (zeros == 2)
+                out[len++] = 'w';
+            else if (zeros == 3)
+                out[len++] = 'x';
+            else if (zeros >= 4)
+            {
+                out[len++] = 'y';
+                out[len++] = digits[zeros - 4]; // até 31 colunas vazias: cabe
+            }
+            zeros = 0;
+            out[len++] = digits[column];
+        }
+    }
+    out[len] = '\0';
+}
+
+// Como o apgsearch: entre todas as fases e as 8 simetrias, o código mais
+// curto e, no empate, o menor na ordem das strings
+static void apgcode(uint32_t phases[][UNIVERSE], int period, int population, char *out)
+{
+    char best[NAME_MAX_LEN] = "", buf[NAME_MAX_LEN];
+    for (int i = 0; i < period; i++)
+    {
+        int minx = UNIVERSE, maxx = -1, miny = UNIVERSE, maxy = -1;
+        for (int y = 0; y < UNIVERSE; y++)
+            if (phases[i][y])
+            {
+                if (y < miny) miny = y;
+                maxy = y;
+                int lo = __builtin_ctz(phases[i][y]), hi = 31 - __builtin_clz(phases[i][y]);
+                if (lo < minx) minx = lo;
+                if (hi > maxx) maxx = hi;
+            }
+        if (maxy < 0)
+            continue;
+        for (int t = 0; t < 8; t++)
+        {
+            wechsler(phases[i], minx, miny, maxx - minx + 1, maxy - miny + 1, t, buf);
+            size_t a = strlen(buf), b = strlen(best);
+            if (!best[0] || a < b || (a == b && strcmp(buf, best) < 0))
+                strcpy(best, buf);
+        }
+    }
+    if (period == 1)
+        snprintf(out, NAME_MAX_LEN, "xs%d_%s", population, best);
+    else
+        snprintf(out, NAME_MAX_LEN, "xp%d_%s", period, best);
+}
+
+// Objetos conhecidos e o quanto valem no placar (0 = comum demais). O
+// apgcode da tabela é conferido em known_init contra o calculado
+typedef struct {
+    const char *name;
+    const char *picture; // linhas separadas por '/', 'o' = viva
+    int period;
+    int weight;
+    const char *apgcode;
+    char key[KEY_MAX];
+} known_t;
+
+static known_t known[] = {
+    { "block", "oo/oo", 1, 0, "xs4_33", "" },
+    { "beehive", ".oo./o..o/.oo.", 1, 0, "xs6_696", "" },
+    { "loaf", ".oo./o..o/.o.o/..o.", 1, 1, "xs7_2596", "" },
+    { "boat", "oo./o.o/.o.", 1, 1, "xs5_253", "" },
+    { "ship", "oo./o.o/.oo", 1, 2, "xs6_356", "" },
+    { "tub", ".o./o.o/.o.", 1, 2, "xs4_252", "" },
+    { "pond", ".oo./o..o/o..o/.oo.", 1, 3, "xs8_6996", "" },
+    { "barge", ".o../o.o./.o.o/..o.", 1, 5, "xs6_25a4", "" },
+    { "long boat", "oo../o.o./.o.o/..o.", 1, 5, "xs7_25ac", "" },
+    { "mango", ".oo../o..o./.o..o/..oo.", 1, 6, "xs8_69ic", "" },
+    { "eater 1", "oo../o.o./..o./..oo", 1, 8, "xs7_178c", "" },
+    { "blinker", "ooo", 2, 0, "xp2_7", "" },
+    { "toad", ".ooo/ooo.", 2, 4, "xp2_7e", "" },
+    { "beacon", "oo../oo../..oo/..oo", 2, 4, "xp2_318c", "" },
+    { "pentadecathlon", "..o....o../oo.oooo.oo/..o....o..", 15, 40, "xp15_4r4z4r4", "" },
+};
+#define KNOWN_COUNT ((int)(sizeof(known) / sizeof(known[0])))
+
+// Fases de um estado: phases[0] = rows, phases[i] = i gerações depois
+static void phases_of(const uint32_t rows[UNIVERSE], int period, uint32_t phases[][UNIVERSE])
+{
+    uint32_t a[UNIVERSE], b[UNIVERSE];
+    life_grid_t cur, next;
+    life_grid_init(&cur, a, UNIVERSE, UNIVERSE);
+    life_grid_init(&next, b, UNIVERSE, UNIVERSE);
+    memcpy(a, rows, sizeof(a));
+    for (int i = 0; i < period; i++)
+    {
+        memcpy(phases[i], a, sizeof(a));
+        life_step(&cur, &next, rule);
+        memcpy(a, b, sizeof(a));
+    }
+}
+
+static void object_key(uint32_t phases[][UNIVERSE], int period, char *key)
+{
+    char tmp[KEY_MAX];
+    key[0] = '\0';
+    for (int i = 0; i < period; i++)
+    {
+        shape_key(phases[i], tmp);
+        if (!key[0] || strcmp(tmp, key) < 0)
+            strcpy(key, tmp);
+    }
+}
+
+// false se algum apgcode calculado não for o publicado
+static bool known_init(void)
+{
+    static uint32_t phases[PERIOD_MAX][UNIVERSE];
+    bool ok = true;
+    for (int k = 0; k < KNOWN_COUNT; k++)
+    {
+        int population = 0;
+        uint32_t rows[UNIVERSE] = {0};
+        int x = 0, y = 0;
+        for (const char *p = known[k].picture; *p; p++)
+        {
+            if (*p == '/')
+            {
+                x = 0;
+                y++;
+                continue;
+            }
+            if (*p == 'o')
+            {
+                rows[8 + y] |= 1u << (8 + x);
+                population++;
+            }
+            x++;
+        }
+        phases_of(rows, known[k].period, phases);
+        object_key(phases, known[k].period, known[k].key);
+
+        char code[NAME_MAX_LEN];
+        apgcode(phases, known[k].period, population, code);
+        if (strcmp(code, known[k].apgcode) != 0)
+        {
+            printf("DIVERGIU: apgcode de %s deu %s, o publicado é %s\n", known[k].name, code,
+                   known[k].apgcode);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+typedef struct {
+    char name[NAME_MAX_LEN];
+    int period;
+    int weight;
+} object_t;
+
+static void name_object(const char *key, uint32_t phases[][UNIVERSE], int period, int population,
+                        object_t *obj)
+{
+    obj->period = period;
+    for (int k = 0; k < KNOWN_COUNT; k++)
+        if (strcmp(key, known[k].key) == 0)
+        {
+            snprintf(obj->name, sizeof(obj->name), "%s", known[k].name);
+            obj->weight = known[k].weight;
+            return;
+        }
+
+    // Desconhecido: pelo apgcode
+    apgcode(phases, period, population, obj->name);
+    obj->weight = period == 1 ? 10 + population / 2 : 20 + 2 * period;
+}
+
+// Células de allowed ligadas à semente, com vizinhança de raio radius
+static void flood(const uint32_t allowed[UNIVERSE], int y0, int radius, uint32_t comp[UNIVERSE])
+{
+    memset(comp, 0, UNIVERSE * sizeof(uint32_t));
+    comp[y0] = allowed[y0] & -allowed[y0];
+    bool grew = true;
+    while (grew)
+    {
+        grew = false;
+        for (int y = 0; y < UNIVERSE; y++)
+        {
+            uint32_t around = 0;
+            for (int dy = -radius; dy <= radius; dy++)
+                if (y + dy >= 0 && y + dy < UNIVERSE)
+                    around |= comp[y + dy];
+            for (int r = 0; r < radius; r++)
+                around |= (around << 1) | (around >> 1);
+            uint32_t next = around & allowed[y];
+            if (next != comp[y])
+            {
+                comp[y] = next;
+                grew = true;
+            }
+        }
+    }
+}
+
+static void mask_phases(uint32_t phases[][UNIVERSE], int period, const uint32_t mask[UNIVERSE],
+                        uint32_t out[][UNIVERSE])
+{
+    for (int i = 0; i < period; i++)
+        for (int y = 0; y < UNIVERSE; y++)
+            out[i][y] = phases[i][y] & mask[y];
+}
+
+static void add_object(uint32_t mine[][UNIVERSE], int period, object_t *obj)
+{
+    int population = 0;
+    for (int y = 0; y < UNIVERSE; y++)
+        population += __builtin_popcount(mine[0][y]);
+
+    int own = period;
+    for (int d = 1; d < period; d++)
+        if (period % d == 0 && memcmp(mine[d], mine[0], sizeof(mine[0])) == 0)
+        {
+            own = d;
+            break;
+        }
+
+    char key[KEY_MAX];
+    object_key(mine, own, key);
+    name_object(key, mine, own, population, obj);
+}
+
+// Grupos da união das fases: células a até 2 de distância ficam juntas, então
+// grupos diferentes não interagem. Dentro de um grupo, se cada pedaço
+// 8-conexo evolui sozinho do mesmo jeito (bloco perto de blinker), os pedaços
+// contam como objetos separados; senão o grupo é um objeto só.
+static int classify(uint32_t phases[][UNIVERSE], int period, object_t *objects)
+{
+    uint32_t left[UNIVERSE];
+    for (int y = 0; y < UNIVERSE; y++)
+    {
+        left[y] = 0;
+        for (int i = 0; i < period; i++)
+            left[y] |= phases[i][y];
+    }
+
+    int count = 0;
+    for (int y0 = 0; y0 < UNIVERSE && count < OBJECTS_MAX; y0++)
+        while (left[y0] && count < OBJECTS_MAX)
+        {
+            uint32_t group[UNIVERSE], rest[UNIVERSE], piece[UNIVERSE];
+            uint32_t mine[PERIOD_MAX][UNIVERSE], alone[PERIOD_MAX + 1][UNIVERSE];
+            flood(left, y0, 2, group);
+            for (int y = 0; y < UNIVERSE; y++)
+                left[y] &= ~group[y];
+
+            // Confere se cada pedaço se sustenta sozinho
+            bool separable = true;
+            int pieces = 0;
+            memcpy(rest, group, sizeof(rest));
+            for (int y = 0; y < UNIVERSE && separable; y++)
+                while (rest[y] && separable)
+                {
+                    flood(rest, y, 1, piece);
+                    for (int r = 0; r < UNIVERSE; r++)
+                        rest[r] &= ~piece[r];
+                    mask_phases(phases, period, piece, mine);
+                    phases_of(mine[0], period + 1, alone);
+                    separable = memcmp(mine, alone, period * sizeof(mine[0])) == 0 &&
+                                memcmp(alone[period], mine[0], sizeof(mine[0])) == 0;
+                    pieces++;
+                }
+
+            if (!separable || pieces == 1)
+            {
+                mask_phases(phases, period, group, mine);
+                add_object(mine, period, &objects[count++]);
+                continue;
+            }
+            memcpy(rest, group, sizeof(rest));
+            for (int y = 0; y < UNIVERSE && count < OBJECTS_MAX; y++)
+                while (rest[y] && count < OBJECTS_MAX)
+                {
+                    flood(rest, y, 1, piece);
+                    for (int r = 0; r < UNIVERSE; r++)
+                        rest[r] &= ~piece[r];
+                    mask_phases(phases, period, piece, mine);
+                    add_object(mine, period, &objects[count++]);
+                }
+        }
+    return count;
+}
+
+// ---------- Resultados ----------
+
+typedef struct {
+    uint64_t index;
+    int score;
+    int gens;   // geração em que o ciclo final começou
+    int period; // 0 = não estabilizou
+    char summary[120];
+} result_t;
+
+typedef struct {
+    char name[NAME_MAX_LEN];
+    int period;
+    uint64_t count;
+} census_entry_t;
+
+typedef struct {
+    census_entry_t entries[CENSUS_SIZE];
+    int used;
+    uint64_t overflow;
+} census_t;
+
+static void census_add(census_t *c, const char *name, int period, uint64_t n)
+{
+    uint32_t h = fnv32(name);
+    for (int i = 0; i < CENSUS_SIZE; i++)
+    {
+        census_entry_t *e = &c->entries[(h + i) % CENSUS_SIZE];
+        if (!e->count)
+        {
+            if (c->used * 4 >= CENSUS_SIZE * 3)
+                break; // quase cheio: conta à parte
+            snprintf(e->name, sizeof(e->name), "%.*s", NAME_MAX_LEN - 1, name);
+            e->period = period;
+            e->count = n;
+            c->used++;
+            return;
+        }
+        if (strcmp(e->name, name) == 0)
+        {
+            e->count += n;
+            return;
+        }
+    }
+    c->overflow += n;
+}
+
+static void top_insert(result_t *top, int *len, const result_t *r)
+{
+    int pos = *len;
+    while (pos > 0 && (top[pos - 1].score < r->score ||
+                       (top[pos - 1].score == r->score && top[pos - 1].index > r->index)))
+        pos--;
+    if (pos >= top_k)
+        return;
+    int last = *len < top_k ? *len : top_k - 1;
+    memmove(&top[pos + 1], &top[pos], (last - pos) * sizeof(result_t));
+    top[pos] = *r;
+    if (*len < top_k)
+        (*len)++;
+}
+
+// ---------- Filas com roubo de trabalho ----------
+
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t *tasks; // início de cada tarefa de TASK_SOUPS sopas
+    int head, tail;  // o dono tira do fim, quem rouba tira do começo
+} deque_t;
+
+typedef struct {
+    bool active;
+    bool edge;
+    uint64_t index;
+    int gen;
+    uint64_t ring[PERIOD_MAX];
+} lane_t;
+
+typedef struct {
+    int id;
+    pthread_t thread;
+    deque_t queue;
+    uint64_t task_next, task_end;
+
+    uint32_t a[UNIVERSE * BATCH], b[UNIVERSE * BATCH];
+    uint32_t *cur, *next;
+    lane_t lanes[BATCH];
+
+    census_t census;
+    result_t top[TOP_MAX];
+    int top_len;
+    uint64_t soups, stabilised, edge, unstable, gens, steals, steps;
+    uint64_t fingerprint; // soma dos resultados: não depende da ordem nem das threads
+} worker_t;
+
+static worker_t *workers;
+static int worker_count;
+
+static bool take_task(worker_t *w, uint64_t *start)
+{
+    pthread_mutex_lock(&w->queue.lock);
+    bool ok = w->queue.tail > w->queue.head;
+    if (ok)
+        *start = w->queue.tasks[--w->queue.tail];
+    pthread_mutex_unlock(&w->queue.lock);
+    if (ok)
+        return true;
+
+    for (int v = 1; v < worker_count; v++)
+    {
+        deque_t *q = &workers[(w->id + v) % worker_count].queue;
+        pthread_mutex_lock(&q->lock);
+        ok = q->tail > q->head;
+        if (ok)
+            *start = q->tasks[q->head++];
+        pthread_mutex_unlock(&q->lock);
+        if (ok)
+        {
+            w->steals++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool next_soup(worker_t *w, uint64_t *index)
+{
+    if (w->task_next == w->task_end)
+    {
+        uint64_t start;
+        if (!take_task(w, &start))
+            return false;
+        w->task_next = start;
+        w->task_end = start + TASK_SOUPS < total_soups ? start + TASK_SOUPS : total_soups;
+    }
+    *index = w->task_next++;
+    return true;
+}
+
+// Põe a próxima sopa na pista l; false se não há mais trabalho
+static bool load_lane(worker_t *w, int l)
+{
+    lane_t *lane = &w->lanes[l];
+    uint32_t rows[UNIVERSE];
+    lane->active = next_soup(w, &lane->index);
+    if (lane->active)
+        make_soup(lane->index, rows);
+    else
+        memset(rows, 0, sizeof(rows));
+
+    for (int y = 0; y < UNIVERSE; y++)
+        w->cur[y * BATCH + l] = rows[y];
+    lane->gen = 0;
+    lane->edge = false;
+    lane->ring[0] = hash_rows(rows, 1);
+    return lane->active;
+}
+
+static void finish_lane(worker_t *w, int l, int period)
+{
+    lane_t *lane = &w->lanes[l];
+    result_t r = { .index = lane->index, .gens = lane->gen - period, .period = period };
+    uint32_t phases[PERIOD_MAX][UNIVERSE];
+    object_t objects[OBJECTS_MAX];
+    int count = 0;
+
+    if (period)
+    {
+        uint32_t rows[UNIVERSE];
+        for (int y = 0; y < UNIVERSE; y++)
+            rows[y] = w->cur[y * BATCH + l];
+        phases_of(rows, period, phases);
+        count = classify(phases, period, objects);
+        w->stabilised++;
+    }
+    else
+    {
+        w->unstable++;
+        r.score = 25;
+        snprintf(r.summary, sizeof(r.summary), "não estabilizou em %d gerações", max_gens);
+    }
+
+    // Resumo da sopa: "2 block, 1 blinker, ..."
+    int len = 0;
+    for (int i = 0; i < count; i++)
+    {
+        bool seen = false;
+        for (int j = 0; j < i && !seen; j++)
+            seen = strcmp(objects[j].name, objects[i].name) == 0;
+        r.score += objects[i].weight;
+        if (!lane->edge)
+            census_add(&w->census, objects[i].name, objects[i].period, 1);
+        w->fingerprint += fnv32(objects[i].name);
+        if (seen)
+            continue;
+        int n = 0;
+        for (int j = i; j < count; j++)
+            n += strcmp(objects[j].name, objects[i].name) == 0;
+        if (len < (int)sizeof(r.summary))
+            len += snprintf(r.summary + len, sizeof(r.summary) - len, "%s%d %s",
+                            len ? ", " : "", n, objects[i].name);
+    }
+    if (period && !count)
+        snprintf(r.summary, sizeof(r.summary), "morreu");
+    r.score += r.gens / 200;
+
+    w->soups++;
+    w->gens += lane->gen;
+    w->fingerprint += lane->index * 0x9E3779B97F4A7C15ull ^ ((uint64_t)lane->gen << 8 | period);
+    if (lane->edge)
+        w->edge++;
+    else if (r.score > 0)
+        top_insert(w->top, &w->top_len, &r);
+}
+
+static void *worker_thread(void *arg)
+{
+    worker_t *w = arg;
+    w->cur = w->a;
+    w->next = w->b;
+    int live = 0;
+    for (int l = 0; l < BATCH; l++)
+        live += load_lane(w, l);
+
+    uint64_t hash[BATCH];
+    uint32_t edge[BATCH];
+    while (live > 0)
+    {
+        life_step_batch(w->cur, w->next, UNIVERSE, BATCH, rule);
+        uint32_t *tmp = w->cur;
+        w->cur = w->next;
+        w->next = tmp;
+        w->steps++;
+
+        // Hash e borda de todas as pistas, linha a linha
+        for (int l = 0; l < BATCH; l++)
+        {
+            hash[l] = 0xCBF29CE484222325ull;
+            edge[l] = w->cur[l] | w->cur[(UNIVERSE - 1) * BATCH + l];
+        }
+        for (int y = 0; y < UNIVERSE; y++)
+        {
+            const uint32_t *row = &w->cur[y * BATCH];
+            for (int l = 0; l < BATCH; l++)
+            {
+                hash[l] = (hash[l] ^ row[l]) * 0x100000001B3ull;
+                edge[l] |= row[l] & EDGE_MASK;
+            }
+        }
+
+        for (int l = 0; l < BATCH; l++)
+        {
+            lane_t *lane = &w->lanes[l];
+            if (!lane->active)
+                continue;
+            int g = ++lane->gen;
+            lane->edge |= edge[l] != 0;
+
+            int period = 0;
+            for (int p = 1; p <= PERIOD_MAX && p <= g; p++)
+                if (lane->ring[(g - p) % PERIOD_MAX] == hash[l])
+                {
+                    period = p;
+                    break;
+                }
+            lane->ring[g % PERIOD_MAX] = hash[l];
+
+            if (period || g >= max_gens)
+            {
+                finish_lane(w, l, period);
+                live -= !load_lane(w, l);
+            }
+        }
+    }
+    return NULL;
+}
+
+// ---------- Rodada ----------
+
+typedef struct {
+    double seconds;
+    uint64_t soups, stabilised, edge, unstable, gens, steals, steps, fingerprint;
+} run_t;
+
+static run_t run_search(int threads)
+{
+    worker_count = threads;
+    workers = calloc(threads, sizeof(worker_t));
+    uint64_t tasks = (total_soups + TASK_SOUPS - 1) / TASK_SOUPS;
+
+    // Cada thread começa com um bloco contíguo de tarefas
+    for (int i = 0; i < threads; i++)
+    {
+        worker_t *w = &workers[i];
+        w->id = i;
+        pthread_mutex_init(&w->queue.lock, NULL);
+        uint64_t first = tasks * i / threads, last = tasks * (i + 1) / threads;
+        w->queue.tasks = malloc((last - first + 1) * sizeof(uint64_t));
+        for (uint64_t t = last; t > first; t--)
+            w->queue.tasks[w->queue.tail++] = (t - 1) * TASK_SOUPS; // o fim sai primeiro
+    }
+
+    struct timespec t0, t1;
+    clock_gettime(CLOCK_MONOTONIC, &t0);
+    for (int i = 0; i < threads; i++)
+        pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]);
+    for (int i = 0; i < threads; i++)
+        pthread_join(workers[i].thread, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &t1);
+
+    run_t r = { .seconds = (t1.tv_sec - t0.tv_sec) + (t1.tv_nsec - t0.tv_nsec) / 1e9 };
+    for (int i = 0; i < threads; i++)
+    {
+        worker_t *w = &workers[i];
+        r.soups += w->soups;
+        r.stabilised += w->stabilised;
+        r.edge += w->edge;
+        r.unstable += w->unstable;
+        r.gens += w->gens;
+        r.steals += w->steals;
+        r.steps += w->steps;
+        r.fingerprint += w->fingerprint;
+    }
+    return r;
+}
+
+static void free_workers(void)
+{
+    for (int i = 0; i < worker_count; i++)
+        free(workers[i].queue.tasks);
+    free(workers);
+    workers = NULL;
+}
+
+// ---------- Saída ----------
+
+static int cmp_census(const void *a, const void *b)
+{
+    const census_entry_t *x = a, *y = b;
+    if (x->count != y->count)
+        return x->count < y->count ? 1 : -1;
+    return strcmp(x->name, y->name);
+}
+
+static void print_census(void)
+{
+    static census_t total;
+    memset(&total, 0, sizeof(total));
+    for (int i = 0; i < worker_count; i++)
+    {
+        for (int e = 0; e < CENSUS_SIZE; e++)
+            if (workers[i].census.entries[e].count)
+                census_add(&total, workers[i].census.entries[e].name,
+                           workers[i].census.entries[e].period, workers[i].census.entries[e].count);
+        total.overflow += workers[i].census.overflow;
+    }
+
+    census_entry_t *list = malloc(CENSUS_SIZE * sizeof(census_entry_t));
+    int n = 0;
+    for (int e = 0; e < CENSUS_SIZE; e++)
+        if (total.entries[e].count)
+            list[n++] = total.entries[e];
+    qsort(list, n, sizeof(census_entry_t), cmp_census);
+
+    printf("\ncenso (%d tipos, sopas sem borda; apgcodes como no Catagolue):\n", n);
+    for (int i = 0; i < n && i < 25; i++)
+    {
+        const char *code = list[i].name;
+        for (int k = 0; k < KNOWN_COUNT; k++)
+            if (strcmp(list[i].name, known[k].name) == 0)
+                code = known[k].apgcode;
+        printf("  %-24s %-16s p%-3d %12llu\n", list[i].name, code == list[i].name ? "" : code,
+               list[i].period, (unsigned long long)list[i].count);
+    }
+    if (n > 25)
+        printf("  ... mais %d tipos\n", n - 25);
+    if (total.overflow)
+        printf("  (%llu objetos fora da tabela)\n", (unsigned long long)total.overflow);
+    free(list);
+}
+
+// Payload de pico/life com a sopa no centro da tela
+static void soup_payload(uint64_t index, FILE *out)
+{
+    uint32_t rows[UNIVERSE];
+    make_soup(index, rows);
+    const int ox = (LIFE_RENDER_WIDTH - UNIVERSE) / 2, oy = (LIFE_RENDER_HEIGHT - UNIVERSE) / 2;
+    bool first = true;
+    fputc('[', out);
+    for (int y = 0; y < UNIVERSE; y++)
+        for (int x = 0; x < UNIVERSE; x++)
+            if ((rows[y] >> x) & 1u)
+            {
+                fprintf(out, "%s[%d,%d]", first ? "" : ",", ox + x, oy + y);
+                first = false;
+            }
+    fputc(']', out);
+}
+
+static void print_top(const char *dir)
+{
+    result_t top[TOP_MAX];
+    int len = 0;
+    for (int i = 0; i < worker_count; i++)
+        for (int j = 0; j < workers[i].top_len; j++)
+            top_insert(top, &len, &workers[i].top[j]);
+
+    printf("\nmelhores sopas:\n");
+    for (int i = 0; i < len; i++)
+    {
+        const result_t *r = &top[i];
+        printf("  #%-10llu placar %4d  estável na geração %5d  %s\n",
+               (unsigned long long)r->index, r->score, r->gens, r->summary);
+        if (dir)
+        {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/soup-%llu.json", dir, (unsigned long long)r->index);
+            FILE *f = fopen(path, "w");
+            if (!f)
+            {
+                fprintf(stderr, "%s: não deu para criar\n", path);
+                continue;
+            }
+            soup_payload(r->index, f);
+            fputc('\n', f);
+            fclose(f);
+            printf("     -> %s\n", path);
+        }
+        else
+        {
+            printf("     pico/life ");
+            soup_payload(r->index, stdout);
+            putchar('\n');
+        }
+    }
+}
+
+// ---------- Conferência do kernel em lote ----------
+
+// Cada pista de life_step_batch contra life_step no mesmo universo
+static bool verify_batch(life_rule_t r)
+{
+    static uint32_t a[UNIVERSE * BATCH], b[UNIVERSE * BATCH];
+    uint32_t single[BATCH][UNIVERSE], tmp[UNIVERSE];
+    uint64_t state = 12345;
+    for (int y = 0; y < UNIVERSE; y++)
+        for (int l = 0; l < BATCH; l++)
+            single[l][y] = a[y * BATCH + l] = (uint32_t)splitmix64(&state) & (uint32_t)splitmix64(&state);
+
+    for (int g = 0; g < 64; g++)
+    {
+        life_step_batch(a, b, UNIVERSE, BATCH, r);
+        memcpy(a, b, sizeof(a));
+        for (int l = 0; l < BATCH; l++)
+        {
+            life_grid_t cur, next;
+            cur = (life_grid_t){ .width = UNIVERSE, .height = UNIVERSE, .stride = 1, .cells = single[l] };
+            next = (life_grid_t){ .width = UNIVERSE, .height = UNIVERSE, .stride = 1, .cells = tmp };
+            life_step(&cur, &next, r);
+            memcpy(single[l], tmp, sizeof(tmp));
+            for (int y = 0; y < UNIVERSE; y++)
+                if (single[l][y] != a[y * BATCH + l])
+                {
+                    printf("DIVERGIU: geração %d, universo %d, linha %d\n", g + 1, l, y);
+                    return false;
+                }
+        }
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char *dir = NULL;
+    bool scaling = false;
+    int opt;
+    while ((opt = getopt(argc, argv, "n:j:g:s:z:k:o:S")) != -1)
+    {
+        switch (opt)
+        {
+        case 'n': total_soups = strtoull(optarg, NULL, 10); break;
+        case 'j': threads = atoi(optarg); break;
+        case 'g': max_gens = atoi(optarg); break;
+        case 's': seed = strtoull(optarg, NULL, 10); break;
+        case 'z': soup_size = atoi(optarg); break;
+        case 'k': top_k = atoi(optarg); break;
+        case 'o': dir = optarg; break;
+        case 'S': scaling = true; break;
+        default:
+            fprintf(stderr, "uso: %s [-n sopas] [-j threads] [-g gerações] [-s semente] "
+                            "[-z lado] [-k melhores] [-o pasta] [-S]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > MAX_THREADS) threads = MAX_THREADS;
+    if (top_k < 1) top_k = 1;
+    if (top_k > TOP_MAX) top_k = TOP_MAX;
+    if (max_gens < 1) max_gens = 1;
+    if (soup_size < 1) soup_size = 1;
+    if (soup_size > UNIVERSE - 2) soup_size = UNIVERSE - 2;
+
+    if (!verify_batch(LIFE_RULE_CONWAY) ||
+        !verify_batch((life_rule_t){ .birth = (1u << 3) | (1u << 6), .survive = (1u << 2) | (1u << 3) }))
+        return 1;
+    if (!known_init())
+        return 1;
+
+    char rule_text[LIFE_RULE_TEXT_MAX];
+    life_format_rule(rule, rule_text, sizeof(rule_text));
+    printf("%llu sopas %dx%d em universos %dx%d, regra %s, até %d gerações, semente %llu\n",
+           (unsigned long long)total_soups, soup_size, soup_size, UNIVERSE, UNIVERSE, rule_text,
+           max_gens, (unsigned long long)seed);
+
+    if (scaling)
+    {
+        printf("\nthreads     sopas/s   aceleração  eficiência  roubos\n");
+        double base = 0;
+        uint64_t fingerprint = 0;
+        for (int t = 1;; t = t * 2 < threads ? t * 2 : threads)
+        {
+            run_t r = run_search(t);
+            double rate = r.soups / r.seconds;
+            if (t == 1)
+            {
+                base = rate;
+                fingerprint = r.fingerprint;
+            }
+            printf("%7d %11.0f %11.2fx %10.0f%% %7llu\n", t, rate, rate / base,
+                   100.0 * rate / base / t, (unsigned long long)r.steals);
+            if (r.fingerprint != fingerprint)
+            {
+                printf("DIVERGIU: censo com %d threads diferente do de 1 thread\n", t);
+                return 1;
+            }
+            if (t == threads)
+                break;
+            free_workers();
+        }
+    }
+    else
+    {
+        run_t r = run_search(threads);
+        printf("%d threads: %.2f s, %.0f sopas/s, %.1f M gerações-universo/s, %llu roubos\n",
+               threads, r.seconds, r.soups / r.seconds, r.gens / r.seconds / 1e6,
+               (unsigned long long)r.steals);
+        printf("%llu estabilizaram, %llu sem estabilizar, %llu encostaram na borda, "
+               "média de %.0f gerações\n",
+               (unsigned long long)r.stabilised, (unsigned long long)r.unstable,
+               (unsigned long long)r.edge, r.soups ? (double)r.gens / r.soups : 0.0);
+    }
+
+    print_census();
+    print_top(dir);
+    free_workers();
+    return 0;
+}